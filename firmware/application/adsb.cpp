@@ -23,6 +23,7 @@
 #include "adsb.hpp"
 
 #include "portapack_persistent_memory.hpp"
+#include "crc.hpp"
 
 namespace adsb {
 
@@ -117,30 +118,40 @@ void generate_frame_pos(uint8_t * const adsb_frame, const uint32_t ICAO_address,
 }
 
 void ADSB_generate_CRC(uint8_t * const in_frame) {
-	uint8_t adsb_crc[14];	// Temp buffer
-	uint8_t b, c, s, bitn;
-	const uint32_t crc_poly = 0x1205FFF;
-	
-	in_frame[11] = 0x00;	// Clear CRC
-	in_frame[12] = 0x00;
-	in_frame[13] = 0x00;
-	
-	// Compute CRC
-	memcpy(adsb_crc, in_frame, 14);
-	for (c = 0; c < 11; c++) {
-		for (b = 0; b < 8; b++) {
-			if ((adsb_crc[c] << b) & 0x80) {
-				for (s = 0; s < 25; s++) {
-					bitn = (c * 8) + b + s;
-					if ((crc_poly >> s) & 1) adsb_crc[bitn >> 3] ^= (0x80 >> (bitn & 7));
-				}
-			}
-		}
+	// Mode S parity, generator 0x1FFF409 over the first 88 bits
+	CRCTable<24, 0xfff409> crc { };
+	crc.process_bytes(in_frame, 11);
+
+	const auto parity = crc.checksum();
+	in_frame[11] = (parity >> 16) & 0xFF;
+	in_frame[12] = (parity >> 8) & 0xFF;
+	in_frame[13] = parity & 0xFF;
+}
+
+std::string decode_frame_id(const ADSBFrame& frame) {
+	const auto raw_data = frame.get_raw_data();
+	std::string callsign;
+	
+	// 8 characters, 6 bits each
+	for (size_t c = 0; c < 8; c++) {
+		const size_t bit = 40 + c * 6;
+		const uint32_t bits = (raw_data[bit >> 3] << 8) | raw_data[(bit >> 3) + 1];
+		callsign += icao_id_lut[(bits >> (10 - (bit & 7))) & 0x3F];
 	}
 	
-	// Insert CRC in frame
-	memcpy(&in_frame[11], &adsb_crc[11], 3);
+	return callsign;
+}
+
+bool decode_frame_altitude(const ADSBFrame& frame, int32_t& altitude) {
+	const auto raw_data = frame.get_raw_data();
+	const uint32_t altitude_coded = (raw_data[5] << 4) | (raw_data[6] >> 4);
+	
+	// Only 25ft steps (Q bit set), not Gillham coded 100ft steps
+	if (!(altitude_coded & 0x10))
+		return false;
 	
+	altitude = ((((altitude_coded & 0xFE0) >> 1) | (altitude_coded & 0x00F)) * 25) - 1000;
+	return true;
 }
 
 } /* namespace adsb */
@@ -26,6 +26,8 @@
 #ifndef __ADSB_H__
 #define __ADSB_H__
 
+#include "adsb_frame.hpp"
+
 namespace adsb {
 
 	const char icao_id_lut[65] = "#ABCDEFGHIJKLMNOPQRSTUVWXYZ##### ###############0123456789######";
@@ -38,6 +40,9 @@ namespace adsb {
 	void generate_frame_emergency(uint8_t * const adsb_frame, const uint32_t ICAO_address, const uint8_t code);
 	
 	void ADSB_generate_CRC(uint8_t * const in_message);
+	
+	std::string decode_frame_id(const ADSBFrame& frame);
+	bool decode_frame_altitude(const ADSBFrame& frame, int32_t& altitude);
 
 } /* namespace adsb */
 
@@ -126,6 +126,10 @@ static std::string true_heading(const TrueHeading value) {
 	}
 }
 
+static std::string channel(const Channel value) {
+	return (value == Channel::B_88B) ? "88B" : "87B";
+}
+
 } /* namespace format */
 } /* namespace ais */
 
@@ -139,11 +143,12 @@ void AISLogger::on_packet(const ais::Packet& packet) {
 		entry += (nibble >= 10) ? ('W' + nibble) : ('0' + nibble);
 	}
 
-	log_file.write_entry(packet.received_at(), entry);
-}	
+	log_file.write_entry(packet.received_at(), ais::format::channel(packet.channel()) + " " + entry);
+}
 
 void AISRecentEntry::update(const ais::Packet& packet) {
 	received_count++;
+	last_channel = packet.channel();
 
 	switch(packet.message_id()) {
 	case 1:
@@ -254,6 +259,7 @@ void AISRecentEntryDetailView::paint(Painter& painter) {
 	field_rect = draw_field(painter, field_rect, s, "CoG ", ais::format::course_over_ground(entry_.last_position.course_over_ground));
 	field_rect = draw_field(painter, field_rect, s, "Head", ais::format::true_heading(entry_.last_position.true_heading));
 	field_rect = draw_field(painter, field_rect, s, "Rx #", to_string_dec_uint(entry_.received_count));
+	field_rect = draw_field(painter, field_rect, s, "Ch  ", ais::format::channel(entry_.last_channel));
 }
 
 void AISRecentEntryDetailView::set_entry(const AISRecentEntry& entry) {
@@ -266,7 +272,7 @@ AISAppView::AISAppView(NavigationView&) {
 
 	add_children({
 		&label_channel,
-		&options_channel,
+		&text_channel,
 		&field_rf_amp,
 		&field_lna,
 		&field_vga,
@@ -278,8 +284,6 @@ AISAppView::AISAppView(NavigationView&) {
 
 	recent_entry_detail_view.hidden(true);
 
-	target_frequency_ = initial_target_frequency;
-
 	radio::enable({
 		tuning_frequency(),
 		sampling_rate,
@@ -290,11 +294,6 @@ AISAppView::AISAppView(NavigationView&) {
 		static_cast<int8_t>(receiver_model.vga()),
 	});
 
-	options_channel.on_change = [this](size_t, OptionsField::value_t v) {
-		this->on_frequency_changed(v);
-	};
-	options_channel.set_by_value(target_frequency());
-
 	recent_entries_view.on_select = [this](const AISRecentEntry& entry) {
 		this->on_show_detail(entry);
 	};
@@ -315,7 +314,7 @@ AISAppView::~AISAppView() {
 }
 
 void AISAppView::focus() {
-	options_channel.focus();
+	field_vga.focus();
 }
 
 void AISAppView::set_parent_rect(const Rect new_parent_rect) {
@@ -353,21 +352,8 @@ void AISAppView::on_show_detail(const AISRecentEntry& entry) {
 	recent_entry_detail_view.focus();
 }
 
-void AISAppView::on_frequency_changed(const uint32_t new_target_frequency) {
-	set_target_frequency(new_target_frequency);
-}
-
-void AISAppView::set_target_frequency(const uint32_t new_value) {
-	target_frequency_ = new_value;
-	radio::set_tuning_frequency(tuning_frequency());
-}
-
-uint32_t AISAppView::target_frequency() const {
-	return target_frequency_;
-}
-
 uint32_t AISAppView::tuning_frequency() const {
-	return target_frequency() - (sampling_rate / 4);
+	return target_frequency - (sampling_rate / 4);
 }
 
 } /* namespace ui */
@@ -69,6 +69,7 @@ struct AISRecentEntry {
 	AISPosition last_position;
 	size_t received_count;
 	int8_t navigational_status;
+	ais::Channel last_channel;
 
 	AISRecentEntry(
 	) : AISRecentEntry { 0 }
@@ -83,7 +84,8 @@ struct AISRecentEntry {
 		destination { },
 		last_position { },
 		received_count { 0 },
-		navigational_status { -1 }
+		navigational_status { -1 },
+		last_channel { ais::Channel::A_87B }
 	{
 	}
 
@@ -157,7 +159,9 @@ public:
 	std::string title() const override { return "AIS"; };
 
 private:
-	static constexpr uint32_t initial_target_frequency = 162025000;
+	/* Midway between 87B (161.975MHz) and 88B (162.025MHz), baseband
+	 * decodes both channels at once. */
+	static constexpr uint32_t target_frequency = 162000000;
 	static constexpr uint32_t sampling_rate = 2457600;
 	static constexpr uint32_t baseband_bandwidth = 1750000;
 
@@ -178,13 +182,9 @@ private:
 		"Ch"
 	};
 
-	OptionsField options_channel {
-		{ 3 * 8, 0 * 16 },
-		3,
-		{
-			{ "87B", 161975000 },
-			{ "88B", 162025000 },
-		}
+	Text text_channel {
+		{ 3 * 8, 0 * 16, 7 * 8, 1 * 16 },
+		"87B+88B"
 	};
 
 	RFAmpField field_rf_amp {
@@ -211,24 +211,17 @@ private:
 		Message::ID::AISPacket,
 		[this](Message* const p) {
 			const auto message = static_cast<const AISPacketMessage*>(p);
-			const ais::Packet packet { message->packet };
+			const ais::Packet packet { message->packet, message->channel };
 			if( packet.is_valid() ) {
 				this->on_packet(packet);
 			}
 		}
 	};
 
-	uint32_t target_frequency_ = initial_target_frequency;
-
 	void on_packet(const ais::Packet& packet);
 	void on_show_list();
 	void on_show_detail(const AISRecentEntry& entry);
 
-	void on_frequency_changed(const uint32_t new_target_frequency);
-
-	uint32_t target_frequency() const;
-	void set_target_frequency(const uint32_t new_value);
-
 	uint32_t tuning_frequency() const;
 };
 
@@ -33,6 +33,9 @@ using namespace portapack;
 #include "utility.hpp"
 
 #include "string_format.hpp"
+#include "ctcss.hpp"
+
+#include <algorithm>
 
 namespace ui {
 
@@ -47,16 +50,39 @@ AMOptionsView::AMOptionsView(
 	add_children({
 		&label_config,
 		&options_config,
+		&text_carrier,
+		&label_squelch,
+		&field_squelch,
 	});
 
 	options_config.set_selected_index(receiver_model.am_configuration());
 	options_config.on_change = [this](size_t n, OptionsField::value_t) {
 		receiver_model.set_am_configuration(n);
+		text_carrier.set("");
+	};
+
+	field_squelch.set_value(receiver_model.squelch_level());
+	field_squelch.on_change = [this](int32_t v) {
+		receiver_model.set_squelch_level(v);
 	};
 }
 
+void AMOptionsView::on_carrier(const AMCarrierMessage& message) {
+	// Carrier offset tracked by the synchronous AM demodulator.
+	if( message.locked ) {
+		text_carrier.set(to_string_dec_int(message.offset_hz) + "Hz");
+	} else {
+		text_carrier.set("no lock");
+	}
+}
+
 /* NBFMOptionsView *******************************************************/
 
+static std::string ctcss_tone_string(const size_t index) {
+	const uint32_t tenths = ctcss_tones[index].frequency * 10.0f + 0.5f;
+	return to_string_dec_uint(tenths / 10, 3) + "." + to_string_dec_uint(tenths % 10);
+}
+
 NBFMOptionsView::NBFMOptionsView(
 	const Rect parent_rect, const Style* const style
 ) : View { parent_rect }
@@ -66,12 +92,101 @@ NBFMOptionsView::NBFMOptionsView(
 	add_children({
 		&label_config,
 		&options_config,
+		&label_subtone,
+		&options_subtone,
+		&text_subtone,
+		&label_squelch,
+		&field_squelch,
 	});
 
 	options_config.set_selected_index(receiver_model.nbfm_configuration());
 	options_config.on_change = [this](size_t n, OptionsField::value_t) {
 		receiver_model.set_nbfm_configuration(n);
 	};
+
+	// Squelch gate, CTCSS tones only. -1 leaves the squelch ungated.
+	OptionsField::options_t subtone_options;
+	subtone_options.emplace_back("  off", -1);
+	for(size_t i=0; i<CTCSS_TONES_NB; i++) {
+		subtone_options.emplace_back(ctcss_tone_string(i), i);
+	}
+	options_subtone.set_options(subtone_options);
+
+	const auto gate = receiver_model.nbfm_subtone_gate();
+	options_subtone.set_by_value((gate.type == Subtone::Type::CTCSS) ? gate.code : -1);
+	options_subtone.on_change = [this](size_t, OptionsField::value_t v) {
+		receiver_model.set_nbfm_subtone_gate(
+			(v < 0) ? Subtone { } : Subtone { Subtone::Type::CTCSS, static_cast<uint16_t>(v) }
+		);
+	};
+
+	field_squelch.set_value(receiver_model.squelch_level());
+	field_squelch.on_change = [this](int32_t v) {
+		receiver_model.set_squelch_level(v);
+	};
+}
+
+void NBFMOptionsView::on_subtone(const SubtoneMessage& message) {
+	const auto& detected = message.detected;
+	switch(detected.type) {
+	case Subtone::Type::CTCSS:
+		text_subtone.set(ctcss_tone_string(detected.code));
+		break;
+
+	case Subtone::Type::DCS:
+		// DCS codes are named by their octal digits, "I" marks inverted polarity.
+		text_subtone.set(
+			"D" +
+			to_string_dec_uint((detected.code >> 6) & 7) +
+			to_string_dec_uint((detected.code >> 3) & 7) +
+			to_string_dec_uint((detected.code >> 0) & 7) +
+			(detected.inverted ? "I" : "N")
+		);
+		break;
+
+	default:
+		text_subtone.set("");
+		break;
+	}
+}
+
+/* WFMOptionsView ********************************************************/
+
+WFMOptionsView::WFMOptionsView(
+	const Rect parent_rect, const Style* const style
+) : View { parent_rect }
+{
+	set_style(style);
+
+	add_children({
+		&text_stereo,
+		&text_pi,
+		&text_ps,
+		&text_radiotext,
+	});
+}
+
+void WFMOptionsView::on_status(const WFMStatusMessage& message) {
+	const auto& rds = message.rds;
+
+	text_stereo.set(message.stereo ? "Stereo" : "Mono");
+
+	if( rds.groups == 0 ) {
+		return;
+	}
+
+	text_pi.set(to_string_hex(rds.pi, 4));
+	text_ps.set(std::string(rds.ps.data(), rds.ps.size()));
+
+	// RadioText is up to 64 characters, scroll it through the last field.
+	const size_t length = std::min(rds.radiotext_length, rds.radiotext.size());
+	if( length == 0 ) {
+		text_radiotext.set("");
+		return;
+	}
+	const std::string text = std::string(rds.radiotext.data(), length) + "   ";
+	radiotext_scroll = (radiotext_scroll + 1) % text.size();
+	text_radiotext.set((text.substr(radiotext_scroll) + text).substr(0, 9));
 }
 
 /* AnalogAudioView *******************************************************/
@@ -183,6 +298,8 @@ void AnalogAudioView::on_modulation_changed(const ReceiverModel::Mode modulation
 	waterfall.on_hide();
 	update_modulation(modulation);
 	on_show_options_modulation();
+	// The wideband spectrum image has no audio to analyze.
+	waterfall.set_audio_spectrum(modulation != ReceiverModel::Mode::SpectrumAnalysis);
 	waterfall.on_show();
 }
 
@@ -245,6 +362,10 @@ void AnalogAudioView::on_show_options_modulation() {
 		widget = std::make_unique<NBFMOptionsView>(options_view_rect, &style_options_group);
 		break;
 
+	case ReceiverModel::Mode::WidebandFMAudio:
+		widget = std::make_unique<WFMOptionsView>(options_view_rect, &style_options_group);
+		break;
+
 	default:
 		break;
 	}
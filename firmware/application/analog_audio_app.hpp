@@ -30,6 +30,9 @@
 
 #include "ui_font_fixed_8x16.hpp"
 
+#include "event_m0.hpp"
+#include "message.hpp"
+
 namespace ui {
 
 constexpr Style style_options_group {
@@ -55,8 +58,36 @@ private:
 			{ "DSB ", 0 },
 			{ "USB ", 0 },
 			{ "LSB ", 0 },
+			{ "SAM ", 0 },
 		}
 	};
+
+	Text text_carrier {
+		{ 9 * 8, 0 * 16, 10 * 8, 1 * 16 },
+		"",
+	};
+
+	Text label_squelch {
+		{ 22 * 8, 0 * 16, 2 * 8, 1 * 16 },
+		"SQ",
+	};
+
+	NumberField field_squelch {
+		{ 25 * 8, 0 * 16 },
+		2,
+		{ 0, 99 },
+		1,
+		' ',
+	};
+
+	MessageHandlerRegistration message_handler_carrier {
+		Message::ID::AMCarrier,
+		[this](const Message* const p) {
+			this->on_carrier(*static_cast<const AMCarrierMessage*>(p));
+		}
+	};
+
+	void on_carrier(const AMCarrierMessage& message);
 };
 
 class NBFMOptionsView : public View {
@@ -76,8 +107,84 @@ private:
 			{ " 8k5", 0 },
 			{ "11k ", 0 },
 			{ "16k ", 0 },
+			{ "20k ", 0 },
+		}
+	};
+
+	Text label_subtone {
+		{ 8 * 8, 0 * 16, 1 * 8, 1 * 16 },
+		"T",
+	};
+
+	OptionsField options_subtone {
+		{ 10 * 8, 0 * 16 },
+		5,
+		{ }
+	};
+
+	Text text_subtone {
+		{ 16 * 8, 0 * 16, 5 * 8, 1 * 16 },
+		"",
+	};
+
+	Text label_squelch {
+		{ 22 * 8, 0 * 16, 2 * 8, 1 * 16 },
+		"SQ",
+	};
+
+	NumberField field_squelch {
+		{ 25 * 8, 0 * 16 },
+		2,
+		{ 0, 99 },
+		1,
+		' ',
+	};
+
+	MessageHandlerRegistration message_handler_subtone {
+		Message::ID::Subtone,
+		[this](const Message* const p) {
+			this->on_subtone(*static_cast<const SubtoneMessage*>(p));
 		}
 	};
+
+	void on_subtone(const SubtoneMessage& message);
+};
+
+class WFMOptionsView : public View {
+public:
+	WFMOptionsView(const Rect parent_rect, const Style* const style);
+
+private:
+	Text text_stereo {
+		{ 0 * 8, 0 * 16, 6 * 8, 1 * 16 },
+		"Mono",
+	};
+
+	Text text_pi {
+		{ 7 * 8, 0 * 16, 4 * 8, 1 * 16 },
+		"",
+	};
+
+	Text text_ps {
+		{ 12 * 8, 0 * 16, 8 * 8, 1 * 16 },
+		"",
+	};
+
+	Text text_radiotext {
+		{ 21 * 8, 0 * 16, 9 * 8, 1 * 16 },
+		"",
+	};
+
+	size_t radiotext_scroll { 0 };
+
+	MessageHandlerRegistration message_handler_status {
+		Message::ID::WFMStatus,
+		[this](const Message* const p) {
+			this->on_status(*static_cast<const WFMStatusMessage*>(p));
+		}
+	};
+
+	void on_status(const WFMStatusMessage& message);
 };
 
 class AnalogAudioView : public View {
@@ -146,7 +253,7 @@ private:
 		u"AUD_????", RecordView::FileType::WAV, 4096, 4
 	};
 
-	spectrum::WaterfallWidget waterfall { };
+	spectrum::WaterfallWidget waterfall { true };
 
 	void on_tuning_frequency_changed(rf::Frequency f);
 	void on_baseband_bandwidth_changed(uint32_t bandwidth_hz);
@@ -24,11 +24,15 @@
 
 #include "audio.hpp"
 #include "dsp_iir_config.hpp"
+#include "dsp_fir_design.hpp"
 
 #include "portapack_shared_memory.hpp"
 
 #include "core_control.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace baseband {
 
 static void send_message(const Message* const message) {
@@ -39,41 +43,75 @@ static void send_message(const Message* const message) {
 	while(shared_memory.baseband_message);
 }
 
-void AMConfig::apply() const {
+void AMConfig::apply(const size_t squelch_level) const {
+	/* Decimation filters pass the whole channel and stop just short of
+	 * where aliases would fold back into it. The channel filter is a
+	 * lowpass prototype shifted to the channel center.
+	 */
+	constexpr float decim_0_input_fs = 3072000;
+	constexpr float decim_1_input_fs = decim_0_input_fs / 8;
+	constexpr float decim_2_input_fs = decim_1_input_fs / 8;
+	constexpr float channel_filter_input_fs = decim_2_input_fs / 4;
+	constexpr float channel_filter_transition = 325;
+
+	const float channel_center = (channel_low + channel_high) * 0.5f;
+	const float channel_pass = (channel_high - channel_low) * 0.5f;
+	const float channel_edge = std::max(std::abs(channel_low), std::abs(channel_high));
+
+	const float decim_2_stop = channel_filter_input_fs - channel_edge;
+	const float decim_1_stop = decim_2_input_fs - channel_edge;
+	const float decim_0_stop = decim_1_input_fs - decim_1_stop;
+
 	const AMConfigureMessage message {
-		taps_6k0_decim_0,
-		taps_6k0_decim_1,
-		taps_6k0_decim_2,
-		channel,
+		fir_design_lowpass<24>(decim_0_input_fs, channel_edge, decim_0_stop, 1.0f),
+		fir_design_lowpass<32>(decim_1_input_fs, channel_edge, decim_1_stop, 1.0f),
+		fir_design_lowpass<32>(decim_2_input_fs, channel_edge, decim_2_stop, 2.0f),
+		fir_design_bandpass<64>(
+			channel_filter_input_fs, channel_center,
+			channel_pass, channel_pass + channel_filter_transition, 2.0f
+		),
 		modulation,
-		audio_12k_hpf_300hz_config
+		audio_12k_hpf_300hz_config,
+		squelch_level
 	};
 	send_message(&message);
 	audio::set_rate(audio::Rate::Hz_12000);
 }
 
-void NBFMConfig::apply() const {
+void NBFMConfig::apply(const size_t squelch_level) const {
+	constexpr float decim_0_input_fs = 3072000;
+	constexpr float decim_1_input_fs = decim_0_input_fs / 8;
+	constexpr float channel_filter_input_fs = decim_1_input_fs / 8;
+	constexpr float channel_filter_transition = 4000;
+
+	const float channel_pass = channel_bandwidth * 0.5f;
+
+	const float decim_1_stop = channel_filter_input_fs - channel_pass;
+	const float decim_0_stop = decim_1_input_fs - decim_1_stop;
+
 	const NBFMConfigureMessage message {
-		decim_0,
-		decim_1,
-		channel,
+		fir_design_lowpass<24>(decim_0_input_fs, channel_pass, decim_0_stop, 1.0f),
+		fir_design_lowpass<32>(decim_1_input_fs, channel_pass, decim_1_stop, 1.0f),
+		fir_design_lowpass<32>(channel_filter_input_fs, channel_pass, channel_pass + channel_filter_transition, 2.0f),
 		2,
 		deviation,
 		audio_24k_hpf_300hz_config,
-		audio_24k_deemph_300_6_config
+		audio_24k_deemph_300_6_config,
+		squelch_level
 	};
 	send_message(&message);
 	audio::set_rate(audio::Rate::Hz_24000);
 }
 
-void WFMConfig::apply() const {
+void WFMConfig::apply(const size_t squelch_level) const {
 	const WFMConfigureMessage message {
 		taps_200k_wfm_decim_0,
 		taps_200k_wfm_decim_1,
 		taps_64_lp_156_198,
 		75000,
 		audio_48k_hpf_30hz_config,
-		audio_48k_deemph_2122_6_config
+		audio_48k_deemph_2122_6_config,
+		squelch_level
 	};
 	send_message(&message);
 	audio::set_rate(audio::Rate::Hz_48000);
@@ -152,10 +190,8 @@ void set_fsk_data(const uint32_t stream_length, const uint32_t samples_per_bit,
 	send_message(&message);
 }
 
-void set_pocsag(const pocsag::BitRate bitrate) {
-	const POCSAGConfigureMessage message {
-		bitrate
-	};
+void set_pocsag() {
+	const POCSAGConfigureMessage message { };
 	send_message(&message);
 }
 
@@ -189,6 +225,21 @@ void set_spectrum(const size_t sampling_rate, const size_t trigger) {
 	send_message(&message);
 }
 
+void set_audio_buffering(const size_t block_samples, const size_t ring_depth) {
+	const AudioConfigMessage message {
+		block_samples,
+		ring_depth
+	};
+	send_message(&message);
+}
+
+void set_subtone_gate(const Subtone gate) {
+	const SubtoneConfigMessage message {
+		gate
+	};
+	send_message(&message);
+}
+
 static bool baseband_image_running = false;
 
 void run_image(const portapack::spi_flash::image_tag_t image_tag) {
@@ -233,6 +284,22 @@ void spectrum_streaming_stop() {
 	send_message(&message);
 }
 
+void audio_spectrum_streaming_start(const uint32_t rate_hz) {
+	AudioSpectrumStreamingConfigMessage message {
+		AudioSpectrumStreamingConfigMessage::Mode::Running,
+		rate_hz
+	};
+	send_message(&message);
+}
+
+void audio_spectrum_streaming_stop() {
+	AudioSpectrumStreamingConfigMessage message {
+		AudioSpectrumStreamingConfigMessage::Mode::Stopped,
+		0
+	};
+	send_message(&message);
+}
+
 void capture_start(CaptureConfig* const config) {
 	CaptureConfigMessage message { config };
 	send_message(&message);
@@ -36,23 +36,24 @@
 namespace baseband {
 
 struct AMConfig {
-	const fir_taps_complex<64> channel;
 	const AMConfigureMessage::Modulation modulation;
+	// Channel edges relative to the carrier, in Hz.
+	const int32_t channel_low;
+	const int32_t channel_high;
 
-	void apply() const;
+	void apply(const size_t squelch_level) const;
 };
 
 struct NBFMConfig {
-	const fir_taps_real<24> decim_0;
-	const fir_taps_real<32> decim_1;
-	const fir_taps_real<32> channel;
+	// Occupied bandwidth, in Hz.
+	const uint32_t channel_bandwidth;
 	const size_t deviation;
 
-	void apply() const;
+	void apply(const size_t squelch_level) const;
 };
 
 struct WFMConfig {
-	void apply() const;
+	void apply(const size_t squelch_level) const;
 };
 
 void set_tones_data(const uint32_t bw, const uint32_t pre_silence, const uint16_t tone_count,
@@ -66,17 +67,21 @@ void set_ook_data(const uint32_t stream_length, const uint32_t samples_per_bit,
 					const uint32_t pause_symbols);
 void set_fsk_data(const uint32_t stream_length, const uint32_t samples_per_bit, const uint32_t shift,
 					const uint32_t progress_notice);
-void set_pocsag(const pocsag::BitRate bitrate);
+void set_pocsag();
 void set_adsb();
 void set_jammer(const bool run, const jammer::JammerType type, const uint32_t speed);
 void set_rds_data(const uint16_t message_length);
 void set_spectrum(const size_t sampling_rate, const size_t trigger);
+void set_audio_buffering(const size_t block_samples, const size_t ring_depth);
+void set_subtone_gate(const Subtone gate);
 
 void run_image(const portapack::spi_flash::image_tag_t image_tag);
 void shutdown();
 
 void spectrum_streaming_start();
 void spectrum_streaming_stop();
+void audio_spectrum_streaming_start(const uint32_t rate_hz);
+void audio_spectrum_streaming_stop();
 
 void capture_start(CaptureConfig* const config);
 void capture_stop();
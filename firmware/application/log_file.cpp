@@ -22,6 +22,30 @@
 #include "log_file.hpp"
 
 #include "string_format.hpp"
+#include "rtc_time.hpp"
+
+#include <algorithm>
+
+LogFile::LogFile() {
+	signal_token_tick_second = rtc_time::signal_tick_second += [this]() {
+		this->on_tick_second();
+	};
+	sd_card_status_signal_token = sd_card::status_signal += [this](const sd_card::Status status) {
+		this->on_sd_card_status(status);
+	};
+}
+
+LogFile::~LogFile() {
+	sd_card::status_signal -= sd_card_status_signal_token;
+	rtc_time::signal_tick_second -= signal_token_tick_second;
+	flush();
+}
+
+Optional<File::Error> LogFile::append(const std::filesystem::path& filename) {
+	const auto error = file.append(filename);
+	is_open = !error.is_valid();
+	return error;
+}
 
 Optional<File::Error> LogFile::write_entry(const rtc::RTC& datetime, const std::string& entry) {
 	std::string timestamp = to_string_timestamp(datetime);
@@ -29,9 +53,84 @@ Optional<File::Error> LogFile::write_entry(const rtc::RTC& datetime, const std::
 }
 
 Optional<File::Error> LogFile::write_line(const std::string& message) {
-	auto error = file.write_line(message);
-	if( !error.is_valid() ) {
-		file.sync();
+	if( !is_open ) {
+		return { };
+	}
+
+	const size_t line_length = message.size() + 2;
+	if( line_length > (buffer.size() - buffer_used) ) {
+		const auto error = write_buffer();
+		if( error.is_valid() ) {
+			return error;
+		}
+	}
+
+	if( line_length > buffer.size() ) {
+		/* Too long to ever fit in the buffer, write it through. */
+		unsynced = true;
+		return file.write_line(message);
+	}
+
+	std::copy(message.cbegin(), message.cend(), &buffer[buffer_used]);
+	buffer_used += message.size();
+	buffer[buffer_used++] = '\r';
+	buffer[buffer_used++] = '\n';
+
+	if( buffer_used == buffer.size() ) {
+		return write_buffer();
+	}
+
+	return { };
+}
+
+Optional<File::Error> LogFile::write_buffer() {
+	if( buffer_used == 0 ) {
+		return { };
+	}
+
+	const auto result = file.write(buffer.data(), buffer_used);
+	buffer_used = 0;
+	unsynced = true;
+	if( result.is_error() ) {
+		return { result.error() };
+	}
+	return { };
+}
+
+Optional<File::Error> LogFile::flush() {
+	if( !is_open ) {
+		return { };
+	}
+
+	const auto error = write_buffer();
+	if( error.is_valid() ) {
+		return error;
+	}
+
+	seconds_since_sync = 0;
+	if( unsynced ) {
+		unsynced = false;
+		return file.sync();
+	}
+	return { };
+}
+
+void LogFile::on_tick_second() {
+	if( (buffer_used == 0) && !unsynced ) {
+		seconds_since_sync = 0;
+		return;
+	}
+
+	if( ++seconds_since_sync >= sync_interval ) {
+		flush();
+	}
+}
+
+void LogFile::on_sd_card_status(const sd_card::Status status) {
+	if( status != sd_card::Status::Mounted ) {
+		/* Card is gone, nothing more can be written to this file. */
+		buffer_used = 0;
+		unsynced = false;
+		is_open = false;
 	}
-	return error;
 }
@@ -22,25 +22,68 @@
 #ifndef __LOG_FILE_H__
 #define __LOG_FILE_H__
 
+#include <cstddef>
+#include <cstdint>
+#include <array>
 #include <string>
 
 #include "file.hpp"
+#include "signal.hpp"
+#include "sd_card.hpp"
 
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
+/* Lines are collected in RAM and written to the file a sector at a time.
+ * The file is synced (FAT and directory entry updated) every sync_interval
+ * seconds, not on every line. At most buffer_size bytes of lines plus
+ * sync_interval seconds of written data can be lost on power failure or
+ * card removal.
+ */
 class LogFile {
 public:
-	Optional<File::Error> append(const std::filesystem::path& filename) {
-		return file.append(filename);
-	}
+	static constexpr size_t buffer_size = 512;
+	static constexpr uint32_t default_sync_interval = 5;
+
+	LogFile();
+	~LogFile();
+
+	LogFile(const LogFile&) = delete;
+	LogFile(LogFile&&) = delete;
+	LogFile& operator=(const LogFile&) = delete;
+	LogFile& operator=(LogFile&&) = delete;
+
+	Optional<File::Error> append(const std::filesystem::path& filename);
 
 	Optional<File::Error> write_entry(const rtc::RTC& datetime, const std::string& entry);
 
+	/* Write out buffered lines and sync the file. */
+	Optional<File::Error> flush();
+
+	void set_sync_interval(const uint32_t seconds) {
+		sync_interval = seconds;
+	}
+
 private:
 	File file { };
+	bool is_open { false };
+
+	std::array<char, buffer_size> buffer { };
+	size_t buffer_used { 0 };
+
+	/* Data has been written to the file since the last sync. */
+	bool unsynced { false };
+	uint32_t sync_interval { default_sync_interval };
+	uint32_t seconds_since_sync { 0 };
+
+	SignalToken signal_token_tick_second { };
+	SignalToken sd_card_status_signal_token { };
 
 	Optional<File::Error> write_line(const std::string& message);
+	Optional<File::Error> write_buffer();
+
+	void on_tick_second();
+	void on_sd_card_status(const sd_card::Status status);
 };
 
 #endif/*__LOG_FILE_H__*/
@@ -78,7 +78,7 @@ POCSAGAppView::POCSAGAppView(NavigationView& nav) {
 		&field_lna,
 		&field_vga,
 		&button_setfreq,
-		&options_bitrate,
+		&text_bitrate,
 		&check_log,
 		&console
 	});
@@ -92,10 +92,7 @@ POCSAGAppView::POCSAGAppView(NavigationView& nav) {
 		logging = v;
 	};
 	
-	options_bitrate.on_change = [this](size_t, OptionsField::value_t v) {
-		this->on_bitrate_changed(v);
-	};
-	options_bitrate.set_selected_index(1);	// 1200bps
+	baseband::set_pocsag();
 
 	options_freq.on_change = [this](size_t, OptionsField::value_t v) {
 		this->on_band_changed(v);
@@ -132,9 +129,21 @@ void POCSAGAppView::set_parent_rect(const Rect new_parent_rect) {
 	View::set_parent_rect(new_parent_rect);
 }
 
+static size_t bitrate_index(const pocsag::BitRate bitrate) {
+	switch (bitrate) {
+		case pocsag::BitRate::FSK512:	return 0;
+		case pocsag::BitRate::FSK2400:	return 2;
+		default:						return 1;
+	}
+}
+
 void POCSAGAppView::on_packet(const POCSAGPacketMessage * message) {
 	std::string alphanum_text = "";
 	
+	const auto rate_index = bitrate_index(message->packet.bitrate());
+	auto& pocsag_state = pocsag_states[rate_index];
+	auto& last_address = last_addresses[rate_index];
+	
 	// Log raw data whatever it contains
 	if (logger && logging)
 		logger->on_packet(message->packet, target_frequency());
@@ -190,10 +199,6 @@ void POCSAGAppView::on_packet(const POCSAGPacketMessage * message) {
 	}
 }
 
-void POCSAGAppView::on_bitrate_changed(const uint32_t new_bitrate) {
-	baseband::set_pocsag(pocsag_bitrates[new_bitrate]);
-}
-
 void POCSAGAppView::on_band_changed(const uint32_t new_band_frequency) {
 	if (new_band_frequency) set_target_frequency(new_band_frequency);
 }
@@ -67,8 +67,10 @@ private:
 	//static constexpr uint32_t baseband_bandwidth = 1750000;
 
 	bool logging { true };
-	uint32_t last_address = 0xFFFFFFFF;
-	pocsag::POCSAGState pocsag_state { };
+
+	// Baseband decodes all bit rates at once, keep batch state per rate
+	std::array<uint32_t, 3> last_addresses { { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF } };
+	std::array<pocsag::POCSAGState, 3> pocsag_states { };
 	
 	MessageHandlerRegistration message_handler_packet {
 		Message::ID::POCSAGPacket,
@@ -111,14 +113,9 @@ private:
 		{ 0, 20, 12 * 8, 20 },
 		"----.----"
 	};
-	OptionsField options_bitrate {
-		{ 13 * 8, 22 },
-		8,
-		{
-			{ "512 bps ", 0 },
-			{ "1200 bps", 1 },
-			{ "2400 bps", 2 }
-		}
+	Text text_bitrate {
+		{ 13 * 8, 22, 8 * 8, 16 },
+		"Any bps"
 	};
 	Checkbox check_log {
 		{ 22 * 8, 22 },
@@ -153,7 +150,6 @@ private:
 	void on_show_list();
 
 	void on_band_changed(const uint32_t new_band_frequency);
-	void on_bitrate_changed(const uint32_t new_bitrate);
 
 	uint32_t target_frequency() const;
 	void set_target_frequency(const uint32_t new_value);
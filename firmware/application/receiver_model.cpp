@@ -31,22 +31,25 @@ using namespace portapack;
 #include "radio.hpp"
 #include "audio.hpp"
 
-#include "dsp_fir_taps.hpp"
 #include "dsp_iir.hpp"
 #include "dsp_iir_config.hpp"
 
+#include <algorithm>
+
 namespace {
 
-static constexpr std::array<baseband::AMConfig, 3> am_configs { {
-	{ taps_6k0_dsb_channel, AMConfigureMessage::Modulation::DSB },
-	{ taps_2k8_usb_channel, AMConfigureMessage::Modulation::SSB },
-	{ taps_2k8_lsb_channel, AMConfigureMessage::Modulation::SSB },	
+static constexpr std::array<baseband::AMConfig, 4> am_configs { {
+	{ AMConfigureMessage::Modulation::DSB, -3000,  3000 },
+	{ AMConfigureMessage::Modulation::SSB,   200,  3000 },
+	{ AMConfigureMessage::Modulation::SSB, -3000,  -200 },
+	{ AMConfigureMessage::Modulation::SAM, -3000,  3000 },
 } };
 
-static constexpr std::array<baseband::NBFMConfig, 3> nbfm_configs { {
-	{ taps_4k25_decim_0, taps_4k25_decim_1, taps_4k25_channel, 2500 },
-	{ taps_11k0_decim_0, taps_11k0_decim_1, taps_11k0_channel, 2500 },
-	{ taps_16k0_decim_0, taps_16k0_decim_1, taps_16k0_channel, 5000 },
+static constexpr std::array<baseband::NBFMConfig, 4> nbfm_configs { {
+	{  8500, 2500 },
+	{ 11000, 2500 },
+	{ 16000, 5000 },
+	{ 20000, 5000 },
 } };
 
 static constexpr std::array<baseband::WFMConfig, 1> wfm_configs { {
@@ -153,6 +156,22 @@ void ReceiverModel::set_headphone_volume(volume_t v) {
 	update_headphone_volume();
 }
 
+size_t ReceiverModel::audio_block_samples() const {
+	return audio_block_samples_;
+}
+
+size_t ReceiverModel::audio_ring_depth() const {
+	return audio_ring_depth_;
+}
+
+void ReceiverModel::set_audio_buffering(const size_t block_samples, const size_t ring_depth) {
+	audio_block_samples_ = block_samples;
+	audio_ring_depth_ = ring_depth;
+	if( enabled_ ) {
+		update_audio_buffering();
+	}
+}
+
 void ReceiverModel::enable() {
 	enabled_ = true;
 	radio::set_direction(rf::Direction::Receive);
@@ -166,6 +185,7 @@ void ReceiverModel::enable() {
 	update_sampling_rate();
 	update_modulation();
 	update_headphone_volume();
+	update_audio_buffering();
 	led_rx.on();
 }
 
@@ -229,6 +249,17 @@ void ReceiverModel::set_nbfm_configuration(const size_t n) {
 	}
 }
 
+Subtone ReceiverModel::nbfm_subtone_gate() const {
+	return nbfm_subtone_gate_;
+}
+
+void ReceiverModel::set_nbfm_subtone_gate(const Subtone gate) {
+	nbfm_subtone_gate_ = gate;
+	if( enabled_ && (modulation() == Mode::NarrowbandFMAudio) ) {
+		baseband::set_subtone_gate(nbfm_subtone_gate_);
+	}
+}
+
 void ReceiverModel::set_wfm_configuration(const size_t n) {
 	if( n < wfm_configs.size() ) {
 		wfm_config_index = n;
@@ -236,6 +267,15 @@ void ReceiverModel::set_wfm_configuration(const size_t n) {
 	}
 }
 
+size_t ReceiverModel::squelch_level() const {
+	return squelch_level_;
+}
+
+void ReceiverModel::set_squelch_level(const size_t v) {
+	squelch_level_ = std::min<size_t>(v, 99);
+	update_modulation();
+}
+
 void ReceiverModel::update_sampling_rate() {
 	// TODO: Move more low-level radio control stuff to M4. It'll enable tighter
 	// synchronization for things like wideband (sweeping) spectrum analysis, and
@@ -253,6 +293,11 @@ void ReceiverModel::update_headphone_volume() {
 	audio::headphone::set_volume(headphone_volume_);
 }
 
+void ReceiverModel::update_audio_buffering() {
+	// Every baseband image handles this; unsupported combinations are ignored.
+	baseband::set_audio_buffering(audio_block_samples_, audio_ring_depth_);
+}
+
 void ReceiverModel::update_modulation() {
 	switch(modulation()) {
 	default:
@@ -278,7 +323,7 @@ size_t ReceiverModel::am_configuration() const {
 }
 
 void ReceiverModel::update_am_configuration() {
-	am_configs[am_config_index].apply();
+	am_configs[am_config_index].apply(squelch_level_);
 }
 
 size_t ReceiverModel::nbfm_configuration() const {
@@ -286,7 +331,8 @@ size_t ReceiverModel::nbfm_configuration() const {
 }
 
 void ReceiverModel::update_nbfm_configuration() {
-	nbfm_configs[nbfm_config_index].apply();
+	nbfm_configs[nbfm_config_index].apply(squelch_level_);
+	baseband::set_subtone_gate(nbfm_subtone_gate_);
 }
 
 size_t ReceiverModel::wfm_configuration() const {
@@ -294,5 +340,5 @@ size_t ReceiverModel::wfm_configuration() const {
 }
 
 void ReceiverModel::update_wfm_configuration() {
-	wfm_configs[wfm_config_index].apply();
+	wfm_configs[wfm_config_index].apply(squelch_level_);
 }
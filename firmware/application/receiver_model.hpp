@@ -72,6 +72,10 @@ public:
 	volume_t headphone_volume() const;
 	void set_headphone_volume(volume_t v);
 
+	size_t audio_block_samples() const;
+	size_t audio_ring_depth() const;
+	void set_audio_buffering(const size_t block_samples, const size_t ring_depth);
+
 	void enable();
 	void disable();
 
@@ -81,9 +85,16 @@ public:
 	size_t nbfm_configuration() const;
 	void set_nbfm_configuration(const size_t n);
 
+	Subtone nbfm_subtone_gate() const;
+	void set_nbfm_subtone_gate(const Subtone gate);
+
 	size_t wfm_configuration() const;
 	void set_wfm_configuration(const size_t n);
 
+	/* Noise squelch for AM/NFM/WFM audio, 0 (open) to 99 (tightest). */
+	size_t squelch_level() const;
+	void set_squelch_level(const size_t v);
+
 private:
 	rf::Frequency frequency_step_ { 25000 };
 	bool enabled_ { false };
@@ -97,8 +108,12 @@ private:
 	uint32_t sampling_rate_ { 3072000 };
 	size_t am_config_index = 0;
 	size_t nbfm_config_index = 0;
+	Subtone nbfm_subtone_gate_ { };
 	size_t wfm_config_index = 0;
+	size_t squelch_level_ { 0 };
 	volume_t headphone_volume_ { -43.0_dB };
+	size_t audio_block_samples_ { 32 };
+	size_t audio_ring_depth_ { 4 };
 
 	int32_t tuning_offset();
 
@@ -111,6 +126,7 @@ private:
 	void update_tx_gain();
 	void update_sampling_rate();
 	void update_headphone_volume();
+	void update_audio_buffering();
 
 	void update_modulation();
 	void update_am_configuration();
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2017 Furrtek
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ui_adsbrx.hpp"
+
+#include "baseband_api.hpp"
+
+#include "portapack.hpp"
+using namespace portapack;
+
+#include "string_format.hpp"
+
+const ADSBRecentEntry::Key ADSBRecentEntry::invalid_key = 0xffffffff;
+
+void ADSBRecentEntry::update(const adsb::ADSBFrame& frame) {
+	hits++;
+
+	const auto df = frame.get_DF();
+	if( (df != 17) && (df != 18) ) {
+		return;
+	}
+
+	const auto tc = frame.get_TC();
+	if( (tc >= 1) && (tc <= 4) ) {
+		callsign = adsb::decode_frame_id(frame);
+	} else if( (tc >= 9) && (tc <= 18) ) {
+		altitude_valid = adsb::decode_frame_altitude(frame, altitude);
+	}
+}
+
+void ADSBLogger::on_frame(const adsb::ADSBFrame& frame) {
+	const auto raw_data = frame.get_raw_data();
+	std::string entry;
+
+	for(size_t i=0; i<frame.length(); i++) {
+		entry += to_string_hex(raw_data[i], 2);
+	}
+
+	log_file.write_entry(frame.get_rx_timestamp(), entry);
+}
+
+namespace ui {
+
+template<>
+void RecentEntriesTable<ADSBRecentEntries>::draw(
+	const Entry& entry,
+	const Rect& target_rect,
+	Painter& painter,
+	const Style& style
+) {
+	std::string callsign = entry.callsign;
+	callsign.resize(8, ' ');
+
+	std::string line = to_string_hex(entry.ICAO_address, 6) + " " + callsign + " ";
+
+	if( entry.altitude_valid ) {
+		line += to_string_dec_int(entry.altitude, 6);
+	} else {
+		line += "      ";
+	}
+
+	if( entry.hits > 9999 ) {
+		line += " ++++";
+	} else {
+		line += " " + to_string_dec_uint(entry.hits, 4);
+	}
+
+	line.resize(target_rect.width() / 8, ' ');
+	painter.draw_string(target_rect.location(), style, line);
+}
+
+ADSBRxView::ADSBRxView(NavigationView&) {
+	baseband::run_image(portapack::spi_flash::image_tag_adsb_rx);
+
+	add_children({
+		&field_rf_amp,
+		&field_lna,
+		&field_vga,
+		&rssi,
+		&recent_entries_view,
+	});
+
+	radio::enable({
+		target_frequency,
+		sampling_rate,
+		baseband_bandwidth,
+		rf::Direction::Receive,
+		receiver_model.rf_amp(),
+		static_cast<int8_t>(receiver_model.lna()),
+		static_cast<int8_t>(receiver_model.vga()),
+	});
+
+	logger = std::make_unique<ADSBLogger>();
+	if( logger ) {
+		logger->append(u"adsb.txt");
+	}
+}
+
+ADSBRxView::~ADSBRxView() {
+	radio::disable();
+
+	baseband::shutdown();
+}
+
+void ADSBRxView::focus() {
+	field_vga.focus();
+}
+
+void ADSBRxView::set_parent_rect(const Rect new_parent_rect) {
+	View::set_parent_rect(new_parent_rect);
+	recent_entries_view.set_parent_rect({ 0, header_height, new_parent_rect.width(), new_parent_rect.height() - header_height });
+}
+
+void ADSBRxView::on_frame(const adsb::ADSBFrame& frame) {
+	if( logger ) {
+		logger->on_frame(frame);
+	}
+
+	auto& entry = ::on_packet(recent, frame.get_ICAO_address());
+	entry.update(frame);
+	recent_entries_view.set_dirty();
+}
+
+} /* namespace ui */
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2017 Furrtek
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __UI_ADSB_RX_H__
+#define __UI_ADSB_RX_H__
+
+#include "ui_navigation.hpp"
+#include "ui_receiver.hpp"
+#include "ui_rssi.hpp"
+
+#include "event_m0.hpp"
+
+#include "log_file.hpp"
+
+#include "adsb.hpp"
+
+#include "recent_entries.hpp"
+
+#include <cstddef>
+#include <string>
+
+struct ADSBRecentEntry {
+	using Key = uint32_t;
+
+	static const Key invalid_key;
+
+	uint32_t ICAO_address { };
+
+	size_t hits { 0 };
+
+	std::string callsign { };
+	bool altitude_valid { false };
+	int32_t altitude { 0 };
+
+	ADSBRecentEntry(
+		const Key& key
+	) : ICAO_address { key }
+	{
+	}
+
+	Key key() const {
+		return ICAO_address;
+	}
+
+	void update(const adsb::ADSBFrame& frame);
+};
+
+class ADSBLogger {
+public:
+	Optional<File::Error> append(const std::filesystem::path& filename) {
+		return log_file.append(filename);
+	}
+	
+	void on_frame(const adsb::ADSBFrame& frame);
+
+private:
+	LogFile log_file { };
+};
+
+using ADSBRecentEntries = RecentEntries<ADSBRecentEntry>;
+
+namespace ui {
+
+using ADSBRecentEntriesView = RecentEntriesView<ADSBRecentEntries>;
+
+class ADSBRxView : public View {
+public:
+	static constexpr uint32_t target_frequency = 1090000000;
+	static constexpr uint32_t sampling_rate = 2000000;
+	static constexpr uint32_t baseband_bandwidth = 2500000;
+
+	ADSBRxView(NavigationView& nav);
+	~ADSBRxView();
+
+	void set_parent_rect(const Rect new_parent_rect) override;
+
+	// Prevent painting of region covered entirely by a child.
+	// TODO: Add flag to View that specifies view does not need to be cleared before painting.
+	void paint(Painter&) override { };
+
+	void focus() override;
+
+	std::string title() const override { return "ADS-B receive"; };
+
+private:
+	ADSBRecentEntries recent { };
+	std::unique_ptr<ADSBLogger> logger { };
+
+	const RecentEntriesColumns columns { {
+		{ "ICAO", 6 },
+		{ "Callsign", 8 },
+		{ "Alt", 6 },
+		{ "Hits", 4 },
+	} };
+	ADSBRecentEntriesView recent_entries_view { columns, recent };
+
+	static constexpr auto header_height = 1 * 16;
+
+	RFAmpField field_rf_amp {
+		{ 13 * 8, 0 * 16 }
+	};
+
+	LNAGainField field_lna {
+		{ 15 * 8, 0 * 16 }
+	};
+
+	VGAGainField field_vga {
+		{ 18 * 8, 0 * 16 }
+	};
+
+	RSSI rssi {
+		{ 21 * 8, 0, 6 * 8, 4 },
+	};
+
+	MessageHandlerRegistration message_handler_frame {
+		Message::ID::ADSBFrame,
+		[this](Message* const p) {
+			const auto message = static_cast<const ADSBFrameMessage*>(p);
+			this->on_frame(message->frame);
+		}
+	};
+
+	void on_frame(const adsb::ADSBFrame& frame);
+};
+
+} /* namespace ui */
+
+#endif/*__UI_ADSB_RX_H__*/
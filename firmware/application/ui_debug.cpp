@@ -27,6 +27,10 @@
 #include "string_format.hpp"
 
 #include "audio.hpp"
+#include "baseband_api.hpp"
+
+#include "portapack.hpp"
+using namespace portapack;
 
 // #include "ui_sd_card_debug.hpp"
 
@@ -244,6 +248,95 @@ void RegistersView::focus() {
 	button_done.focus();
 }
 
+/* DebugAudioView ********************************************************/
+
+DebugAudioView::DebugAudioView(NavigationView& nav) {
+	add_children({
+		&label_block,
+		&options_block,
+		&label_ring,
+		&options_ring,
+		&label_active,
+		&text_active,
+		&label_processing,
+		&text_processing,
+		&label_block_fill,
+		&text_block_fill,
+		&label_queue,
+		&text_queue,
+		&label_total,
+		&text_total,
+		&label_total_max,
+		&text_total_max,
+		&text_note,
+		&button_done,
+	});
+
+	options_block.set_by_value(receiver_model.audio_block_samples());
+	options_block.on_change = [this](size_t, OptionsField::value_t) {
+		this->on_buffering_changed();
+	};
+	options_ring.set_by_value(receiver_model.audio_ring_depth());
+	options_ring.on_change = [this](size_t, OptionsField::value_t) {
+		this->on_buffering_changed();
+	};
+
+	button_done.on_select = [&nav](Button&){ nav.pop(); };
+
+	// Measure against whichever audio mode the receiver was last used in.
+	auto modulation = receiver_model.modulation();
+	portapack::spi_flash::image_tag_t image_tag;
+	switch(modulation) {
+	case ReceiverModel::Mode::AMAudio:				image_tag = portapack::spi_flash::image_tag_am_audio;	break;
+	case ReceiverModel::Mode::WidebandFMAudio:		image_tag = portapack::spi_flash::image_tag_wfm_audio;	break;
+	default:
+		modulation = ReceiverModel::Mode::NarrowbandFMAudio;
+		image_tag = portapack::spi_flash::image_tag_nfm_audio;
+		break;
+	}
+
+	baseband::run_image(image_tag);
+
+	receiver_model.set_modulation(modulation);
+	receiver_model.set_sampling_rate(3072000);
+	receiver_model.set_baseband_bandwidth(1750000);
+	receiver_model.enable();
+
+	audio::output::start();
+}
+
+DebugAudioView::~DebugAudioView() {
+	audio::output::stop();
+
+	receiver_model.disable();
+
+	baseband::shutdown();
+}
+
+void DebugAudioView::focus() {
+	options_block.focus();
+}
+
+void DebugAudioView::on_buffering_changed() {
+	receiver_model.set_audio_buffering(
+		options_block.selected_index_value(),
+		options_ring.selected_index_value()
+	);
+}
+
+void DebugAudioView::on_latency(const AudioLatency& latency) {
+	const auto us_to_string = [](const uint32_t us) {
+		return to_string_dec_uint(us / 1000, 4, ' ') + "." + to_string_dec_uint((us % 1000) / 100) + "ms";
+	};
+
+	text_active.set(to_string_dec_uint(latency.block_samples) + " x " + to_string_dec_uint(latency.ring_depth));
+	text_processing.set(us_to_string(latency.processing_us));
+	text_block_fill.set(us_to_string(latency.block_us));
+	text_queue.set(us_to_string(latency.queue_us));
+	text_total.set(us_to_string(latency.total_us()));
+	text_total_max.set(us_to_string(latency.total_max_us));
+}
+
 /* DebugPeripheralsMenuView **********************************************/
 
 DebugPeripheralsMenuView::DebugPeripheralsMenuView(NavigationView& nav) {
@@ -271,12 +364,13 @@ DebugPeripheralsMenuView::DebugPeripheralsMenuView(NavigationView& nav) {
 /* DebugMenuView *********************************************************/
 
 DebugMenuView::DebugMenuView(NavigationView& nav) {
-	add_items<4>({ {
+	add_items<5>({ {
 		{ "Memory", 		ui::Color::white(),	nullptr,	[&nav](){ nav.push<DebugMemoryView>(); } },
 		{ "Radio State",	ui::Color::white(),	nullptr,	[&nav](){ nav.push<NotImplementedView>(); } },
 		//{ "SD Card",		ui::Color::white(),	nullptr,	[&nav](){ nav.push<SDCardDebugView>(); } },
 		{ "Peripherals",	ui::Color::white(),	nullptr,	[&nav](){ nav.push<DebugPeripheralsMenuView>(); } },
 		{ "Temperature",	ui::Color::white(),	nullptr,	[&nav](){ nav.push<TemperatureView>(); } },
+		{ "Audio latency",	ui::Color::white(),	nullptr,	[&nav](){ nav.push<DebugAudioView>(); } },
 	} });
 	on_left = [&nav](){ nav.pop(); };
 }
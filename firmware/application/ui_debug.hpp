@@ -32,6 +32,9 @@
 #include "max2837.hpp"
 #include "portapack.hpp"
 
+#include "event_m0.hpp"
+#include "message.hpp"
+
 #include <functional>
 #include <utility>
 
@@ -227,6 +230,126 @@ private:
 	};
 };
 
+/* Runs the current receiver mode and shows measured RF->speaker audio latency,
+ * with the audio DMA block size and ring depth adjustable.
+ */
+class DebugAudioView : public View {
+public:
+	DebugAudioView(NavigationView& nav);
+	~DebugAudioView();
+
+	void focus() override;
+
+	std::string title() const override { return "Audio latency"; };
+
+private:
+	Text label_block {
+		{ 1 * 8, 1 * 16, 12 * 8, 16 },
+		"Block size",
+	};
+
+	OptionsField options_block {
+		{ 20 * 8, 1 * 16 },
+		3,
+		{
+			{ "  8", 8 },
+			{ " 16", 16 },
+			{ " 32", 32 },
+			{ " 64", 64 },
+		}
+	};
+
+	Text label_ring {
+		{ 1 * 8, 2 * 16, 12 * 8, 16 },
+		"Ring depth",
+	};
+
+	OptionsField options_ring {
+		{ 20 * 8, 2 * 16 },
+		3,
+		{
+			{ "  2", 2 },
+			{ "  4", 4 },
+			{ "  8", 8 },
+			{ " 16", 16 },
+		}
+	};
+
+	Text label_active {
+		{ 1 * 8, 4 * 16, 12 * 8, 16 },
+		"Active",
+	};
+
+	Text text_active {
+		{ 14 * 8, 4 * 16, 15 * 8, 16 },
+	};
+
+	Text label_processing {
+		{ 1 * 8, 5 * 16, 12 * 8, 16 },
+		"Processing",
+	};
+
+	Text text_processing {
+		{ 14 * 8, 5 * 16, 15 * 8, 16 },
+	};
+
+	Text label_block_fill {
+		{ 1 * 8, 6 * 16, 12 * 8, 16 },
+		"Block fill",
+	};
+
+	Text text_block_fill {
+		{ 14 * 8, 6 * 16, 15 * 8, 16 },
+	};
+
+	Text label_queue {
+		{ 1 * 8, 7 * 16, 12 * 8, 16 },
+		"DMA queue",
+	};
+
+	Text text_queue {
+		{ 14 * 8, 7 * 16, 15 * 8, 16 },
+	};
+
+	Text label_total {
+		{ 1 * 8, 8 * 16, 12 * 8, 16 },
+		"Total",
+	};
+
+	Text text_total {
+		{ 14 * 8, 8 * 16, 15 * 8, 16 },
+	};
+
+	Text label_total_max {
+		{ 1 * 8, 9 * 16, 12 * 8, 16 },
+		"Total max",
+	};
+
+	Text text_total_max {
+		{ 14 * 8, 9 * 16, 15 * 8, 16 },
+	};
+
+	Text text_note {
+		{ 1 * 8, 11 * 16, 28 * 8, 16 },
+		"Excludes filter delays",
+	};
+
+	Button button_done {
+		{ 72, 264, 96, 24 },
+		"Done"
+	};
+
+	MessageHandlerRegistration message_handler_latency {
+		Message::ID::AudioLatency,
+		[this](const Message* const p) {
+			this->on_latency(static_cast<const AudioLatencyMessage*>(p)->latency);
+		}
+	};
+
+	void on_buffering_changed();
+	void on_latency(const AudioLatency& latency);
+};
+
 class DebugPeripheralsMenuView : public MenuView {
 public:
 	DebugPeripheralsMenuView(NavigationView& nav);
@@ -32,6 +32,7 @@
 #include "bmp_modal_warning.hpp"
 
 #include "ui_about.hpp"
+#include "ui_adsbrx.hpp"
 #include "ui_adsbtx.hpp"
 #include "ui_bht_tx.hpp"
 #include "ui_closecall.hpp"
@@ -165,8 +166,8 @@ void SystemStatusView::on_camera() {
 		return;
 	}
 
-	PNGWriter png;
-	auto create_error = png.create(path.replace_extension(u".PNG"));
+	auto png = std::make_unique<PNGWriter>();
+	auto create_error = png->create(path.replace_extension(u".PNG"));
 	if( create_error.is_valid() ) {
 		return;
 	}
@@ -174,7 +175,7 @@ void SystemStatusView::on_camera() {
 	for(int i=0; i<320; i++) {
 		std::array<ColorRGB888, 240> row;
 		portapack::display.read_pixels({ 0, i, 240, 1 }, row);
-		png.write_scanline(row);
+		png->write_scanline(row);
 	}
 }
 
@@ -277,7 +278,7 @@ void NavigationView::focus() {
 
 TranspondersMenuView::TranspondersMenuView(NavigationView& nav) {
 	add_items<4>({ {
-		{ "ADS-B: Planes", 			ui::Color::grey(),	&bitmap_icon_adsb,	[&nav](){ nav.push<NotImplementedView>(); }, },
+		{ "ADS-B: Planes", 			ui::Color::white(),	&bitmap_icon_adsb,	[&nav](){ nav.push<ADSBRxView>(); }, },
 		{ "AIS:   Boats", 			ui::Color::white(),	&bitmap_icon_ais,	[&nav](){ nav.push<AISAppView>(); } },
 		{ "ERT:   Utility Meters", 	ui::Color::white(), &bitmap_icon_ert,	[&nav](){ nav.push<ERTAppView>(); } },
 		{ "TPMS:  Cars", 			ui::Color::white(),	&bitmap_icon_tpms,	[&nav](){ nav.push<TPMSAppView>(); } },
@@ -353,7 +354,7 @@ void SystemMenuView::hackrf_mode(NavigationView& nav) {
 }
 
 SystemMenuView::SystemMenuView(NavigationView& nav) {
-	add_items<12>({ {
+	add_items<13>({ {
 		{ "Play dead",				ui::Color::red(),	&bitmap_icon_playdead,	[&nav](){ nav.push<PlayDeadView>(); } },
 		{ "Receivers", 				ui::Color::cyan(),	&bitmap_icon_receivers,	[&nav](){ nav.push<ReceiverMenuView>(); } },
 		{ "Capture",				ui::Color::cyan(),	&bitmap_icon_capture,	[&nav](){ nav.push<CaptureAppView>(); } },	//CaptureAppView
@@ -364,7 +365,7 @@ SystemMenuView::SystemMenuView(NavigationView& nav) {
 		{ "Jammer", 				ui::Color::orange(),&bitmap_icon_jammer,	[&nav](){ nav.push<JammerView>(); } },
 		{ "Utilities",				ui::Color::purple(),nullptr,				[&nav](){ nav.push<UtilitiesView>(); } },
 		{ "Setup", 					ui::Color::white(),	nullptr,				[&nav](){ nav.push<SetupMenuView>(); } },
-		//{ "Debug", 					ui::Color::white(), nullptr,   				[&nav](){ nav.push<DebugMenuView>(); } },
+		{ "Debug", 					ui::Color::white(),	nullptr,				[&nav](){ nav.push<DebugMenuView>(); } },
 		{ "HackRF mode", 			ui::Color::white(),	&bitmap_icon_hackrf,	[this, &nav](){ hackrf_mode(nav); } },
 		{ "About", 					ui::Color::white(),	nullptr,				[&nav](){ nav.push<AboutView>(); } }
 	} });
@@ -82,7 +82,7 @@ bool POCSAGTXView::start_tx() {
 		}
 	}
 	
-	pocsag_encode(type, BCH_code, message, address, codewords);
+	pocsag_encode(type, message, address, codewords);
 	
 	total_frames = codewords.size() / 2;
 	
@@ -28,7 +28,6 @@
 #include "ui_navigation.hpp"
 #include "ui_receiver.hpp"
 #include "ui_transmitter.hpp"
-#include "bch_code.hpp"
 #include "message.hpp"
 #include "transmitter_model.hpp"
 #include "pocsag.hpp"
@@ -57,11 +56,6 @@ private:
 	std::string message { };
 	NavigationView& nav_;
 
-	BCHCode BCH_code {
-		{ 1, 0, 1, 0, 0, 1 },
-		5, 31, 21, 2
-	};
-	
 	void on_set_text(NavigationView& nav);
 	void on_tx_progress(const int progress, const bool done);
 	bool start_tx();
@@ -61,6 +61,13 @@ void FrequencyScale::set_channel_filter(
 	}
 }
 
+void FrequencyScale::set_one_sided(const bool new_one_sided) {
+	if( one_sided != new_one_sided ) {
+		one_sided = new_one_sided;
+		set_dirty();
+	}
+}
+
 void FrequencyScale::paint(Painter& painter) {
 	const auto r = screen_rect();
 
@@ -75,23 +82,43 @@ void FrequencyScale::paint(Painter& painter) {
 	draw_frequency_ticks(painter, r);
 }
 
+bool FrequencyScale::on_key(const KeyEvent key) {
+	if( (key == KeyEvent::Select) && on_select ) {
+		on_select();
+		return true;
+	}
+
+	return false;
+}
+
+bool FrequencyScale::on_touch(const TouchEvent event) {
+	if( (event.type == TouchEvent::Type::End) && on_select ) {
+		on_select();
+		return true;
+	}
+
+	return false;
+}
+
 void FrequencyScale::clear() {
 	spectrum_sampling_rate = 0;
 	set_dirty();
 }
 
 void FrequencyScale::clear_background(Painter& painter, const Rect r) {
-	painter.fill_rectangle(r, Color::black());
+	painter.fill_rectangle(r, has_focus() ? Color::dark_grey() : Color::black());
 }
 
 void FrequencyScale::draw_frequency_ticks(Painter& painter, const Rect r) {
-	const auto x_center = r.width() / 2;
+	const auto x_center = one_sided ? 0 : r.width() / 2;
+	// One-sided bins cover half the sampling rate.
+	const int bins_span = one_sided ? spectrum_sampling_rate / 2 : spectrum_sampling_rate;
 
 	const Rect tick { r.left() + x_center, r.top(), 1, r.height() };
 	painter.fill_rectangle(tick, Color::white());
 
 	constexpr int tick_count_max = 4;
-	float rough_tick_interval = float(spectrum_sampling_rate) / tick_count_max;
+	float rough_tick_interval = float(bins_span) / tick_count_max;
 	int magnitude = 1;
 	int magnitude_n = 0;
 	while(rough_tick_interval >= 10.0f) {
@@ -103,7 +130,10 @@ void FrequencyScale::draw_frequency_ticks(Painter& painter, const Rect r) {
 
 	auto tick_offset = tick_interval;
 	while((tick_offset * magnitude) < spectrum_sampling_rate / 2) {
-		const Dim pixel_offset = tick_offset * magnitude * spectrum_bins / spectrum_sampling_rate;
+		const Dim pixel_offset = tick_offset * magnitude * spectrum_bins / bins_span;
+		if( pixel_offset >= r.width() - x_center ) {
+			break;
+		}
 
 		const std::string zero_pad =
 			((magnitude_n % 3) == 0) ? "" :
@@ -114,10 +144,12 @@ void FrequencyScale::draw_frequency_ticks(Painter& painter, const Rect r) {
 		const std::string label = to_string_dec_uint(tick_offset) + zero_pad + unit;
 		const auto label_width = style().font.size_of(label).width();
 		
-		const Coord offset_low = r.left() + x_center - pixel_offset;
-		const Rect tick_low { offset_low, r.top(), 1, r.height() };
-		painter.fill_rectangle(tick_low, Color::white());
-		painter.draw_string({ offset_low + 2, r.top() }, style(), label );
+		if( !one_sided ) {
+			const Coord offset_low = r.left() + x_center - pixel_offset;
+			const Rect tick_low { offset_low, r.top(), 1, r.height() };
+			painter.fill_rectangle(tick_low, Color::white());
+			painter.draw_string({ offset_low + 2, r.top() }, style(), label );
+		}
 
 		const Coord offset_high = r.left() + x_center + pixel_offset;
 		const Rect tick_high { offset_high, r.top(), 1, r.height() };
@@ -209,6 +241,22 @@ void WaterfallView::on_channel_spectrum(
 		pixel_row[i] = pixel_color;
 	}
 
+	draw_row(pixel_row);
+}
+
+void WaterfallView::on_audio_spectrum(
+	const ChannelSpectrum& spectrum
+) {
+	// One-sided, 0Hz on the left: the first 240 bins, up to 0.47 * fs.
+	std::array<Color, 240> pixel_row;
+	for(size_t i=0; i<pixel_row.size(); i++) {
+		pixel_row[i] = spectrum_rgb3_lut[spectrum.db[i]];
+	}
+
+	draw_row(pixel_row);
+}
+
+void WaterfallView::draw_row(const std::array<Color, 240>& pixel_row) {
 	const auto draw_y = display.scroll(1);
 
 	display.draw_pixels(
@@ -226,19 +274,68 @@ void WaterfallView::clear() {
 
 /* WaterfallWidget *******************************************************/
 
-WaterfallWidget::WaterfallWidget() {
+WaterfallWidget::WaterfallWidget(const bool audio_spectrum) {
 	add_children({
 		&waterfall_view,
 		&frequency_scale,
 	});
+
+	frequency_scale.on_select = [this]() {
+		if( this->audio_spectrum_enabled ) {
+			this->set_source((this->source == Source::Channel) ? Source::Audio : Source::Channel);
+		}
+	};
+	set_audio_spectrum(audio_spectrum);
 }
 
 void WaterfallWidget::on_show() {
-	baseband::spectrum_streaming_start();
+	streaming_start();
 }
 
 void WaterfallWidget::on_hide() {
-	baseband::spectrum_streaming_stop();
+	streaming_stop();
+}
+
+void WaterfallWidget::set_source(const Source new_source) {
+	if( new_source != source ) {
+		const bool was_streaming = streaming;
+		if( was_streaming ) {
+			streaming_stop();
+		}
+		source = new_source;
+		frequency_scale.set_one_sided(source == Source::Audio);
+		if( was_streaming ) {
+			streaming_start();
+		}
+	}
+}
+
+void WaterfallWidget::set_audio_spectrum(const bool enabled) {
+	audio_spectrum_enabled = enabled;
+	frequency_scale.set_focusable(enabled);
+	if( !enabled ) {
+		set_source(Source::Channel);
+	}
+}
+
+void WaterfallWidget::streaming_start() {
+	streaming = true;
+	if( source == Source::Audio ) {
+		baseband::audio_spectrum_streaming_start(audio_spectrum_rate_hz);
+	} else {
+		baseband::spectrum_streaming_start();
+	}
+}
+
+void WaterfallWidget::streaming_stop() {
+	streaming = false;
+	// Drop the FIFO until the baseband sends it again, the other source may follow.
+	fifo = nullptr;
+	if( source == Source::Audio ) {
+		baseband::audio_spectrum_streaming_stop();
+	} else {
+		baseband::spectrum_streaming_stop();
+	}
 }
 
 void WaterfallWidget::set_parent_rect(const Rect new_parent_rect) {
@@ -259,7 +356,11 @@ void WaterfallWidget::paint(Painter& painter) {
 }
 
 void WaterfallWidget::on_channel_spectrum(const ChannelSpectrum& spectrum) {
-	waterfall_view.on_channel_spectrum(spectrum);
+	if( source == Source::Audio ) {
+		waterfall_view.on_audio_spectrum(spectrum);
+	} else {
+		waterfall_view.on_channel_spectrum(spectrum);
+	}
 	frequency_scale.set_spectrum_sampling_rate(spectrum.sampling_rate);
 	frequency_scale.set_channel_filter(
 		spectrum.channel_filter_pass_frequency,
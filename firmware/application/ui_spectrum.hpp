@@ -31,23 +31,33 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <array>
+#include <functional>
 
 namespace ui {
 namespace spectrum {
 
 class FrequencyScale : public Widget {
 public:
+	std::function<void(void)> on_select { };
+
 	void on_show() override;
 
 	void set_spectrum_sampling_rate(const int new_sampling_rate);
 	void set_channel_filter(const int pass_frequency, const int stop_frequency);
+	/* One-sided (audio) spectrum: 0Hz at the left edge, bins span fs/2. */
+	void set_one_sided(const bool new_one_sided);
 
 	void paint(Painter& painter) override;
 
+	bool on_key(const KeyEvent key) override;
+	bool on_touch(const TouchEvent event) override;
+
 private:
 	static constexpr int filter_band_height = 4;
 
 	int spectrum_sampling_rate { 0 };
+	bool one_sided { false };
 	const int spectrum_bins = std::tuple_size<decltype(ChannelSpectrum::db)>::value;
 	int channel_filter_pass_frequency { 0 };
 	int channel_filter_stop_frequency { 0 };
@@ -67,14 +77,24 @@ public:
 	void paint(Painter& painter) override;
 
 	void on_channel_spectrum(const ChannelSpectrum& spectrum);
+	void on_audio_spectrum(const ChannelSpectrum& spectrum);
 
 private:
 	void clear();
+	void draw_row(const std::array<Color, 240>& pixel_row);
 };
 
 class WaterfallWidget : public View {
 public:
-	WaterfallWidget();
+	enum class Source {
+		Channel,
+		Audio,
+	};
+
+	/* With audio_spectrum, selecting the frequency scale switches between the
+	 * channel and the audio spectrum. Only for baseband images using AudioOutput.
+	 */
+	WaterfallWidget(const bool audio_spectrum = false);
 
 	WaterfallWidget(const WaterfallWidget&) = delete;
 	WaterfallWidget(WaterfallWidget&&) = delete;
@@ -88,10 +108,22 @@ public:
 
 	void paint(Painter& painter) override;
 
+	void set_source(const Source new_source);
+
+	/* Turns the source toggle on or off, falling back to the channel
+	 * spectrum. For baseband images without audio.
+	 */
+	void set_audio_spectrum(const bool enabled);
+
 private:
+	static constexpr uint32_t audio_spectrum_rate_hz = 20;
+
 	WaterfallView waterfall_view { };
 	FrequencyScale frequency_scale { };
 	ChannelSpectrumFIFO* fifo { nullptr };
+	Source source { Source::Channel };
+	bool audio_spectrum_enabled { false };
+	bool streaming { false };
 
 	MessageHandlerRegistration message_handler_spectrum_config {
 		Message::ID::ChannelSpectrumConfig,
@@ -100,6 +132,13 @@ private:
 			this->fifo = message.fifo;
 		}
 	};
+	MessageHandlerRegistration message_handler_audio_spectrum_config {
+		Message::ID::AudioSpectrumConfig,
+		[this](const Message* const p) {
+			const auto message = *reinterpret_cast<const AudioSpectrumConfigMessage*>(p);
+			this->fifo = message.fifo;
+		}
+	};
 	MessageHandlerRegistration message_handler_frame_sync {
 		Message::ID::DisplayFrameSync,
 		[this](const Message* const) {
@@ -113,6 +152,9 @@ private:
 	};
 
 	void on_channel_spectrum(const ChannelSpectrum& spectrum);
+
+	void streaming_start();
+	void streaming_stop();
 };
 
 } /* namespace spectrum */
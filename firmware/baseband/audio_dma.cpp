@@ -123,19 +123,15 @@ constexpr gpdma::channel::Config config_rx() {
 
 constexpr size_t buffer_samples_log2n = 7;
 constexpr size_t buffer_samples = (1 << buffer_samples_log2n);
-constexpr size_t transfers_per_buffer_log2n = 2;
-constexpr size_t transfers_per_buffer = (1 << transfers_per_buffer_log2n);
-constexpr size_t transfer_samples = buffer_samples / transfers_per_buffer;
-constexpr size_t transfers_mask = transfers_per_buffer - 1;
 
-constexpr size_t buffer_bytes = buffer_samples * sizeof(sample_t);
-constexpr size_t transfer_bytes = transfer_samples * sizeof(sample_t);
+static size_t transfers_per_buffer_ = 4;
+static size_t transfer_samples_ = buffer_samples / transfers_per_buffer_;
 
 static std::array<sample_t, buffer_samples> buffer_tx;
 static std::array<sample_t, buffer_samples> buffer_rx;
 
-static std::array<gpdma::channel::LLI, transfers_per_buffer> lli_tx_loop;
-static std::array<gpdma::channel::LLI, transfers_per_buffer> lli_rx_loop;
+static std::array<gpdma::channel::LLI, transfers_per_buffer_max> lli_tx_loop;
+static std::array<gpdma::channel::LLI, transfers_per_buffer_max> lli_rx_loop;
 
 static constexpr auto& gpdma_channel_i2s0_tx = gpdma::channels[portapack::i2s0_tx_gpdma_channel_number];
 static constexpr auto& gpdma_channel_i2s0_rx = gpdma::channels[portapack::i2s0_rx_gpdma_channel_number];
@@ -143,7 +139,15 @@ static constexpr auto& gpdma_channel_i2s0_rx = gpdma::channels[portapack::i2s0_r
 static volatile const gpdma::channel::LLI* tx_next_lli = nullptr;
 static volatile const gpdma::channel::LLI* rx_next_lli = nullptr;
 
+static volatile uint32_t tx_complete_ticks = 0;
+
+/* Written by tx_empty_buffer() only, from the baseband thread. */
+static size_t tx_write_index = 0;
+static size_t tx_write_lead = 0;
+static bool tx_write_started = false;
+
 static void tx_transfer_complete() {
+	tx_complete_ticks = halGetCounterValue();
 	tx_next_lli = gpdma_channel_i2s0_tx.next_lli();
 }
 
@@ -169,24 +173,24 @@ void init() {
 
 static void configure_tx() {
 	const auto peripheral = reinterpret_cast<uint32_t>(&LPC_I2S0->TXFIFO);
-	const auto control_value = control_tx(transfer_bytes);
-	for(size_t i=0; i<lli_tx_loop.size(); i++) {
-		const auto memory = reinterpret_cast<uint32_t>(&buffer_tx[i * transfer_samples]);
+	const auto control_value = control_tx(transfer_samples_ * sizeof(sample_t));
+	for(size_t i=0; i<transfers_per_buffer_; i++) {
+		const auto memory = reinterpret_cast<uint32_t>(&buffer_tx[i * transfer_samples_]);
 		lli_tx_loop[i].srcaddr = memory;
 		lli_tx_loop[i].destaddr = peripheral;
-		lli_tx_loop[i].lli = lli_pointer(&lli_tx_loop[(i + 1) % lli_tx_loop.size()]);
+		lli_tx_loop[i].lli = lli_pointer(&lli_tx_loop[(i + 1) % transfers_per_buffer_]);
 		lli_tx_loop[i].control = control_value;
 	}
 }
 
 static void configure_rx() {
 	const auto peripheral = reinterpret_cast<uint32_t>(&LPC_I2S0->RXFIFO);
-	const auto control_value = control_rx(transfer_bytes);
-	for(size_t i=0; i<lli_rx_loop.size(); i++) {
-		const auto memory = reinterpret_cast<uint32_t>(&buffer_rx[i * transfer_samples]);
+	const auto control_value = control_rx(transfer_samples_ * sizeof(sample_t));
+	for(size_t i=0; i<transfers_per_buffer_; i++) {
+		const auto memory = reinterpret_cast<uint32_t>(&buffer_rx[i * transfer_samples_]);
 		lli_rx_loop[i].srcaddr = peripheral;
 		lli_rx_loop[i].destaddr = memory;
-		lli_rx_loop[i].lli = lli_pointer(&lli_rx_loop[(i + 1) % lli_rx_loop.size()]);
+		lli_rx_loop[i].lli = lli_pointer(&lli_rx_loop[(i + 1) % transfers_per_buffer_]);
 		lli_rx_loop[i].control = control_value;
 	}
 }
@@ -212,27 +216,106 @@ void disable() {
 	gpdma_channel_i2s0_rx.disable();
 }
 
+static constexpr bool is_power_of_two(const size_t n) {
+	return (n != 0) && ((n & (n - 1)) == 0);
+}
+
+bool set_buffering(const size_t new_transfer_samples, const size_t new_transfers_per_buffer) {
+	if( !is_power_of_two(new_transfer_samples) || !is_power_of_two(new_transfers_per_buffer) ) {
+		return false;
+	}
+	if( (new_transfer_samples < transfer_samples_min) || (new_transfer_samples > transfer_samples_max) ) {
+		return false;
+	}
+	if( (new_transfers_per_buffer < 2) || (new_transfers_per_buffer > transfers_per_buffer_max) ) {
+		return false;
+	}
+	if( (new_transfer_samples * new_transfers_per_buffer) > buffer_samples ) {
+		return false;
+	}
+
+	// Receivers resend the config on every enable, don't restart DMA for nothing.
+	if( (new_transfer_samples == transfer_samples_) && (new_transfers_per_buffer == transfers_per_buffer_) ) {
+		return true;
+	}
+
+	disable();
+
+	tx_next_lli = nullptr;
+	rx_next_lli = nullptr;
+	tx_write_started = false;
+	buffer_tx.fill({ });
+
+	transfer_samples_ = new_transfer_samples;
+	transfers_per_buffer_ = new_transfers_per_buffer;
+	configure();
+
+	enable();
+
+	return true;
+}
+
+size_t transfer_samples() {
+	return transfer_samples_;
+}
+
+size_t transfers_per_buffer() {
+	return transfers_per_buffer_;
+}
+
+/* One baseband buffer can produce several audio blocks in a burst, so blocks go
+ * to consecutive transfers rather than to the one that just completed. "Lead"
+ * counts transfers queued ahead of a block: 0 is next_lli, transfers_per_buffer
+ * - 1 is the transfer playing now, which is never handed out. A block that would
+ * land there (ring full) is dropped.
+ */
 buffer_t tx_empty_buffer() {
 	const auto next_lli = tx_next_lli;
-	if( next_lli ) {
-		const size_t next_index = next_lli - &lli_tx_loop[0];
-		const size_t free_index = (next_index + transfers_per_buffer - 2) & transfers_mask;
-		return { reinterpret_cast<sample_t*>(lli_tx_loop[free_index].srcaddr), transfer_samples };
-	} else {
+	if( !next_lli ) {
+		tx_write_started = false;
 		return { nullptr, 0 };
 	}
+
+	const size_t mask = transfers_per_buffer_ - 1;
+	const size_t next_index = next_lli - &lli_tx_loop[0];
+	if( !tx_write_started ) {
+		// Start with the transfer that just completed, as far ahead as possible.
+		tx_write_index = (next_index + mask - 1) & mask;
+		tx_write_started = true;
+	}
+
+	const size_t lead = (tx_write_index - next_index) & mask;
+	if( lead == mask ) {
+		return { nullptr, 0 };
+	}
+
+	tx_write_lead = lead;
+	const size_t write_index = tx_write_index;
+	tx_write_index = (tx_write_index + 1) & mask;
+	return { reinterpret_cast<sample_t*>(lli_tx_loop[write_index].srcaddr), transfer_samples_ };
 }
 
 buffer_t rx_empty_buffer() {
 	const auto next_lli = rx_next_lli;
 	if( next_lli ) {
 		const size_t next_index = next_lli - &lli_rx_loop[0];
-		const size_t free_index = (next_index + transfers_per_buffer - 2) & transfers_mask;
-		return { reinterpret_cast<sample_t*>(lli_rx_loop[free_index].srcaddr), transfer_samples };
+		const size_t free_index = (next_index + transfers_per_buffer_ - 2) & (transfers_per_buffer_ - 1);
+		return { reinterpret_cast<sample_t*>(lli_rx_loop[free_index].srcaddr), transfer_samples_ };
 	} else {
 		return { nullptr, 0 };
 	}
 }
 
+uint32_t tx_queue_ticks(const uint32_t now, const uint32_t sampling_rate) {
+	/* The last buffer from tx_empty_buffer() plays once the transfer playing
+	 * now (started at tx_complete_ticks) and the lead transfers queued ahead of
+	 * it have gone out.
+	 */
+	const uint32_t transfer_ticks = static_cast<uint64_t>(halGetCounterFrequency()) * transfer_samples_ / sampling_rate;
+	const uint32_t queued_ticks = transfer_ticks * (tx_write_lead + 1);
+	const uint32_t elapsed_ticks = now - tx_complete_ticks;
+	return (elapsed_ticks < queued_ticks) ? (queued_ticks - elapsed_ticks) : 0;
+}
+
 } /* namespace dma */
 } /* namespace audio */
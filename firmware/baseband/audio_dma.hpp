@@ -23,6 +23,7 @@
 #define __AUDIO_DMA_H__
 
 #include <cstdint>
+#include <cstddef>
 
 #include "buffer.hpp"
 
@@ -47,9 +48,30 @@ void configure();
 void enable();
 void disable();
 
+constexpr size_t transfer_samples_min = 8;
+constexpr size_t transfer_samples_max = 64;
+constexpr size_t transfers_per_buffer_max = 16;
+
+/* Reconfigures transfer (block) size and ring depth, both powers of two, with
+ * transfer_samples * transfers_per_buffer no larger than the 128-sample ring.
+ * Smaller blocks and a shallower ring lower latency at the cost of more
+ * interrupts and less tolerance to processing jitter. Returns false and leaves
+ * the DMA untouched if the combination isn't supported.
+ */
+bool set_buffering(const size_t transfer_samples, const size_t transfers_per_buffer);
+
+size_t transfer_samples();
+size_t transfers_per_buffer();
+
 audio::buffer_t tx_empty_buffer();
 audio::buffer_t rx_empty_buffer();
 
+/* Counter ticks from `now` until a buffer just returned by tx_empty_buffer()
+ * starts playing. The I2S frame rate is set by the application core along
+ * with the codec, so the caller supplies it.
+ */
+uint32_t tx_queue_ticks(const uint32_t now, const uint32_t sampling_rate);
+
 } /* namespace dma */
 } /* namespace audio */
 
@@ -24,12 +24,16 @@
 #include "portapack_shared_memory.hpp"
 
 #include "audio_dma.hpp"
+#include "baseband_dma.hpp"
+
+#include "hal.h"
 
 #include "message.hpp"
 
 #include <cstdint>
 #include <cstddef>
 #include <array>
+#include <algorithm>
 
 void AudioOutput::configure(
 	const bool do_proc
@@ -40,30 +44,70 @@ void AudioOutput::configure(
 void AudioOutput::configure(
 	const iir_biquad_config_t& hpf_config,
 	const iir_biquad_config_t& deemph_config,
-	const float squelch_threshold
+	const size_t squelch_level
 ) {
-	hpf.configure(hpf_config);
-	deemph.configure(deemph_config);
-	squelch.set_threshold(squelch_threshold);
+	audio_filter.configure({ { hpf_config, deemph_config } });
+	hpf_s16.configure(hpf_config);
+	deemph_s16.configure(deemph_config);
+	hpf_difference.configure(hpf_config);
+	deemph_difference.configure(deemph_config);
+	// Level 1 closes on near full scale noise, 99 on 1% of full scale.
+	const size_t level = std::min<size_t>(squelch_level, 99);
+	squelch.set_threshold((level == 0) ? 0.0f : ((100 - level) * 0.01f));
 }
 
 void AudioOutput::write(
 	const buffer_s16_t& audio
 ) {
-	std::array<float, 32> audio_f;
-	for(size_t i=0; i<audio.count; i++) {
-		audio_f[i] = audio.p[i] * ki;
+	difference_in_step = false;
+	block_buffer_s16.set_block_size(audio::dma::transfer_samples());
+	block_buffer_s16.feed(
+		audio,
+		[this](const buffer_s16_t& buffer) {
+			this->on_block(buffer);
+		}
+	);
+}
+
+void AudioOutput::write(
+	const buffer_s16_t& audio,
+	const buffer_s16_t& difference
+) {
+	const size_t block_size = audio::dma::transfer_samples();
+	block_buffer_s16.set_block_size(block_size);
+	block_buffer_difference.set_block_size(block_size);
+
+	// Mono writes leave the difference decimator behind, realign both.
+	if( !difference_in_step ) {
+		block_buffer_s16.reset();
+		block_buffer_difference.reset();
+		difference_in_step = true;
+	}
+
+	/* Both decimators see the same counts and complete blocks together. Feeding
+	 * at most one block at a time keeps each block paired with its difference.
+	 */
+	for(size_t offset=0; offset<audio.count; offset+=block_size) {
+		const size_t count = std::min(block_size, audio.count - offset);
+		block_buffer_difference.feed(
+			{ &difference.p[offset], count, difference.sampling_rate },
+			[this](const buffer_s16_t& buffer) {
+				std::copy(&buffer.p[0], &buffer.p[buffer.count], this->difference_block.begin());
+			}
+		);
+		block_buffer_s16.feed(
+			{ &audio.p[offset], count, audio.sampling_rate },
+			[this](const buffer_s16_t& buffer) {
+				this->on_block(buffer, { this->difference_block.data(), buffer.count, buffer.sampling_rate });
+			}
+		);
 	}
-	write(buffer_f32_t {
-		audio_f.data(),
-		audio.count,
-		audio.sampling_rate
-	});
 }
 
 void AudioOutput::write(
 	const buffer_f32_t& audio
 ) {
+	block_buffer.set_block_size(audio::dma::transfer_samples());
 	block_buffer.feed(
 		audio,
 		[this](const buffer_f32_t& buffer) {
@@ -72,20 +116,31 @@ void AudioOutput::write(
 	);
 }
 
+/* Hysteresis is up to the squelch. The tone gate needs none here: the subtone
+ * detector holds both CTCSS and DCS codes across missed blocks.
+ */
+bool AudioOutput::update_squelch(const bool open) {
+	if( open != squelch_open ) {
+		squelch_open = open;
+		const SquelchMessage message { open };
+		shared_memory.application_queue.push(message);
+	}
+	return open;
+}
+
 void AudioOutput::on_block(
 	const buffer_f32_t& audio
 ) {
 	bool audio_present;
+
+	// Demodulator output, ahead of squelch and filters.
+	audio_spectrum.feed(audio);
 	
 	if (do_processing) {
-		const auto audio_present_now = squelch.execute(audio);
+		audio_present = update_squelch(squelch.execute(audio) && gate_open);
 
-		hpf.execute_in_place(audio);
-		deemph.execute_in_place(audio);
+		audio_filter.execute_in_place(audio);
 
-		audio_present_history = (audio_present_history << 1) | (audio_present_now ? 1 : 0);
-		audio_present = (audio_present_history != 0);
-		
 		if( !audio_present ) {
 			for(size_t i=0; i<audio.count; i++) {
 				audio.p[i] = 0;
@@ -97,29 +152,174 @@ void AudioOutput::on_block(
 	fill_audio_buffer(audio, audio_present);
 }
 
+/* int16_t audio stays fixed-point all the way to the DMA buffer. */
+void AudioOutput::on_block(
+	const buffer_s16_t& audio
+) {
+	bool audio_present;
+
+	// Demodulator output, ahead of squelch and filters.
+	audio_spectrum.feed(audio);
+	
+	if (do_processing) {
+		audio_present = update_squelch(squelch.execute(audio) && gate_open);
+
+		hpf_s16.execute_in_place(audio);
+		deemph_s16.execute_in_place(audio);
+
+		if( !audio_present ) {
+			for(size_t i=0; i<audio.count; i++) {
+				audio.p[i] = 0;
+			}
+		}
+	} else
+		audio_present = true;
+
+	fill_audio_buffer(audio, audio_present);
+}
+
+void AudioOutput::on_block(
+	const buffer_s16_t& audio,
+	const buffer_s16_t& difference
+) {
+	bool audio_present;
+
+	// Demodulator output, ahead of squelch and filters.
+	audio_spectrum.feed(audio);
+
+	if (do_processing) {
+		audio_present = update_squelch(squelch.execute(audio) && gate_open);
+
+		// Both filters are linear, so filtering sum and difference filters L and R.
+		hpf_s16.execute_in_place(audio);
+		deemph_s16.execute_in_place(audio);
+		hpf_difference.execute_in_place(difference);
+		deemph_difference.execute_in_place(difference);
+
+		if( !audio_present ) {
+			for(size_t i=0; i<audio.count; i++) {
+				audio.p[i] = 0;
+				difference.p[i] = 0;
+			}
+		}
+	} else
+		audio_present = true;
+
+	fill_audio_buffer(audio, difference, audio_present);
+}
+
 void AudioOutput::fill_audio_buffer(const buffer_f32_t& audio, const bool send_to_fifo) {
-	std::array<int16_t, 32> audio_int;
+	std::array<int16_t, block_samples_max> audio_int;
 
 	auto audio_buffer = audio::dma::tx_empty_buffer();
-	for(size_t i=0; i<audio_buffer.count; i++) {
+	const auto count = std::min(audio.count, audio_buffer.count);
+	for(size_t i=0; i<count; i++) {
 		const int32_t sample_int = audio.p[i] * k;
 		const int32_t sample_saturated = __SSAT(sample_int, 16);
 		audio_buffer.p[i].left = audio_buffer.p[i].right = sample_saturated;
 		audio_int[i] = sample_saturated;
 	}
 	if( stream && send_to_fifo ) {
-		stream->write(audio_int.data(), audio_buffer.count * sizeof(audio_int[0]));
+		stream->write(audio_int.data(), count * sizeof(audio_int[0]));
 	}
 
+	feed_latency(count, audio.sampling_rate);
 	feed_audio_stats(audio);
 }
 
+void AudioOutput::fill_audio_buffer(const buffer_s16_t& audio, const bool send_to_fifo) {
+	auto audio_buffer = audio::dma::tx_empty_buffer();
+	const auto count = std::min(audio.count, audio_buffer.count);
+	for(size_t i=0; i<count; i++) {
+		audio_buffer.p[i].left = audio_buffer.p[i].right = audio.p[i];
+	}
+	if( stream && send_to_fifo ) {
+		stream->write(audio.p, count * sizeof(audio.p[0]));
+	}
+
+	feed_latency(count, audio.sampling_rate);
+	feed_audio_stats(audio);
+}
+
+/* Recording and statistics stay mono (the sum channel). */
+void AudioOutput::fill_audio_buffer(const buffer_s16_t& audio, const buffer_s16_t& difference, const bool send_to_fifo) {
+	auto audio_buffer = audio::dma::tx_empty_buffer();
+	const auto count = std::min(audio.count, audio_buffer.count);
+	for(size_t i=0; i<count; i++) {
+		audio_buffer.p[i].left = __SSAT(audio.p[i] + difference.p[i], 16);
+		audio_buffer.p[i].right = __SSAT(audio.p[i] - difference.p[i], 16);
+	}
+	if( stream && send_to_fifo ) {
+		stream->write(audio.p, count * sizeof(audio.p[0]));
+	}
+
+	feed_latency(count, audio.sampling_rate);
+	feed_audio_stats(audio);
+}
+
+/* Latency of the oldest sample in a block, from RF capture to the speaker:
+ * - processing: newest RF sample captured -> block handed to audio DMA,
+ * - block: the oldest sample waiting for the block to fill,
+ * - queue: audio DMA transfers ahead of this block.
+ * Filter group delays aren't included.
+ */
+void AudioOutput::feed_latency(const size_t block_samples, const uint32_t sampling_rate) {
+	if( (block_samples == 0) || (sampling_rate == 0) ) {
+		return;
+	}
+
+	const uint32_t now = halGetCounterValue();
+	const uint32_t processing_ticks = now - baseband::dma::last_transfer_ticks();
+	const uint32_t block_ticks = static_cast<uint64_t>(halGetCounterFrequency()) * block_samples / sampling_rate;
+	const uint32_t queue_ticks = audio::dma::tx_queue_ticks(now, sampling_rate);
+
+	latency_processing_ticks_sum += processing_ticks;
+	latency_block_ticks_sum += block_ticks;
+	latency_queue_ticks_sum += queue_ticks;
+	latency_total_ticks_max = std::max(latency_total_ticks_max, processing_ticks + block_ticks + queue_ticks);
+	latency_blocks++;
+}
+
+void AudioOutput::send_audio_stats(const AudioStatistics& statistics) {
+	const AudioStatisticsMessage audio_stats_message { statistics };
+	shared_memory.application_queue.push(audio_stats_message);
+
+	if( latency_blocks > 0 ) {
+		const uint64_t ticks_per_us = halGetCounterFrequency() / 1000000U;
+		const uint64_t divisor = ticks_per_us * latency_blocks;
+		const AudioLatency latency {
+			static_cast<uint32_t>(latency_processing_ticks_sum / divisor),
+			static_cast<uint32_t>(latency_block_ticks_sum / divisor),
+			static_cast<uint32_t>(latency_queue_ticks_sum / divisor),
+			static_cast<uint32_t>(latency_total_ticks_max / ticks_per_us),
+			audio::dma::transfer_samples(),
+			audio::dma::transfers_per_buffer()
+		};
+		const AudioLatencyMessage latency_message { latency };
+		shared_memory.application_queue.push(latency_message);
+	}
+
+	latency_processing_ticks_sum = 0;
+	latency_block_ticks_sum = 0;
+	latency_queue_ticks_sum = 0;
+	latency_total_ticks_max = 0;
+	latency_blocks = 0;
+}
+
 void AudioOutput::feed_audio_stats(const buffer_f32_t& audio) {
 	audio_stats.feed(
 		audio,
-		[](const AudioStatistics& statistics) {
-			const AudioStatisticsMessage audio_stats_message { statistics };
-			shared_memory.application_queue.push(audio_stats_message);
+		[this](const AudioStatistics& statistics) {
+			this->send_audio_stats(statistics);
+		}
+	);
+}
+
+void AudioOutput::feed_audio_stats(const buffer_s16_t& audio) {
+	audio_stats.feed(
+		audio,
+		[this](const AudioStatistics& statistics) {
+			this->send_audio_stats(statistics);
 		}
 	);
 }
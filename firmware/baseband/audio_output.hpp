@@ -30,48 +30,95 @@
 #include "stream_input.hpp"
 #include "block_decimator.hpp"
 #include "audio_stats_collector.hpp"
+#include "audio_spectrum_collector.hpp"
+#include "audio_dma.hpp"
 
 #include <cstdint>
 #include <memory>
+#include <array>
 
 class AudioOutput {
 public:
 	void configure(const bool do_proc);
 	
+	/* squelch_level 0 leaves the noise squelch open, 1-99 close it on
+	 * progressively less noise.
+	 */
 	void configure(
 		const iir_biquad_config_t& hpf_config,
 		const iir_biquad_config_t& deemph_config = iir_config_passthrough,
-		const float squelch_threshold = 0.0f
+		const size_t squelch_level = 0
 	);
 
 	void write(const buffer_s16_t& audio);
 	void write(const buffer_f32_t& audio);
+	/* Stereo as sum (L+R)/2 and difference (L-R)/2, same rate and count. */
+	void write(const buffer_s16_t& audio, const buffer_s16_t& difference);
 
 	void set_stream(std::unique_ptr<StreamInput> new_stream) {
 		stream = std::move(new_stream);
 	}
 
-private:
-	static constexpr float k = 32768.0f;
-	static constexpr float ki = 1.0f / k;
+	/* Audio spectrum streaming and updates, see AudioSpectrumCollector. */
+	void on_message(const Message* const message) {
+		audio_spectrum.on_message(message);
+	}
 
-	BlockDecimator<float, 32> block_buffer { 1 };	
+	/* Extra squelch condition, e.g. a matching CTCSS tone. Open by default. */
+	void set_gate(const bool open) {
+		gate_open = open;
+	}
 
-	IIRBiquadFilter hpf { };
-	IIRBiquadFilter deemph { };
-	FMSquelch squelch { };
+private:
+	static constexpr float k = 32768.0f;
+	static constexpr size_t block_samples_max = audio::dma::transfer_samples_max;
+
+	/* Blocks track the audio DMA transfer size, see audio::dma::set_buffering(). */
+	BlockDecimator<float, block_samples_max> block_buffer { 1 };
+	BlockDecimator<int16_t, block_samples_max> block_buffer_s16 { 1 };
+	BlockDecimator<int16_t, block_samples_max> block_buffer_difference { 1 };
+	/* The difference decimator keeps filling its buffer after a block completes,
+	 * so the completed block is copied out until its sum block arrives.
+	 */
+	std::array<int16_t, block_samples_max> difference_block { };
+	bool difference_in_step { false };
+
+	// HPF, then de-emphasis.
+	IIRBiquadCascade<2> audio_filter { };
+	IIRBiquadFilterS16 hpf_s16 { };
+	IIRBiquadFilterS16 deemph_s16 { };
+	IIRBiquadFilterS16 hpf_difference { };
+	IIRBiquadFilterS16 deemph_difference { };
+	NoiseSquelch squelch { };
 
 	std::unique_ptr<StreamInput> stream { };
 
 	AudioStatsCollector audio_stats { };
+	AudioSpectrumCollector audio_spectrum { };
 
-	uint64_t audio_present_history = 0;
+	bool squelch_open { true };
+
+	uint64_t latency_processing_ticks_sum { 0 };
+	uint64_t latency_block_ticks_sum { 0 };
+	uint64_t latency_queue_ticks_sum { 0 };
+	uint32_t latency_total_ticks_max { 0 };
+	size_t latency_blocks { 0 };
 	
 	bool do_processing = true;
+	bool gate_open = true;
+
+	bool update_squelch(const bool open);
 
 	void on_block(const buffer_f32_t& audio);
+	void on_block(const buffer_s16_t& audio);
+	void on_block(const buffer_s16_t& audio, const buffer_s16_t& difference);
 	void fill_audio_buffer(const buffer_f32_t& audio, const bool send_to_fifo);
+	void fill_audio_buffer(const buffer_s16_t& audio, const bool send_to_fifo);
+	void fill_audio_buffer(const buffer_s16_t& audio, const buffer_s16_t& difference, const bool send_to_fifo);
 	void feed_audio_stats(const buffer_f32_t& audio);
+	void feed_audio_stats(const buffer_s16_t& audio);
+	void feed_latency(const size_t block_samples, const uint32_t sampling_rate);
+	void send_audio_stats(const AudioStatistics& statistics);
 };
 
 #endif/*__AUDIO_OUTPUT_H__*/
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "audio_spectrum_collector.hpp"
+
+#include "dsp_fft.hpp"
+
+#include "utility.hpp"
+#include "event_m4.hpp"
+#include "portapack_shared_memory.hpp"
+
+#include <algorithm>
+
+void AudioSpectrumCollector::on_message(const Message* const message) {
+	switch(message->id) {
+	case Message::ID::UpdateSpectrum:
+		update();
+		break;
+
+	case Message::ID::AudioSpectrumStreamingConfig:
+		set_state(*reinterpret_cast<const AudioSpectrumStreamingConfigMessage*>(message));
+		break;
+
+	default:
+		break;
+	}
+}
+
+void AudioSpectrumCollector::set_state(const AudioSpectrumStreamingConfigMessage& message) {
+	if( message.mode == AudioSpectrumStreamingConfigMessage::Mode::Running ) {
+		rate_hz = message.rate_hz ? message.rate_hz : default_rate_hz;
+		interval_samples = 0;
+		start();
+	} else {
+		stop();
+	}
+}
+
+void AudioSpectrumCollector::start() {
+	streaming = true;
+	AudioSpectrumConfigMessage message { &fifo };
+	shared_memory.application_queue.push(message);
+}
+
+void AudioSpectrumCollector::stop() {
+	streaming = false;
+	// A later start() begins a fresh capture, not the tail of this one.
+	capture_count = 0;
+	interval_count = 0;
+	fifo.reset_in();
+}
+
+void AudioSpectrumCollector::feed(const buffer_f32_t& audio) {
+	feed_samples(audio, 1.0f);
+}
+
+void AudioSpectrumCollector::feed(const buffer_s16_t& audio) {
+	feed_samples(audio, 1.0f / 32768.0f);
+}
+
+template<typename T>
+void AudioSpectrumCollector::feed_samples(const buffer_t<T>& audio, const float scale) {
+	// Called from baseband processing thread.
+	if( !streaming ) {
+		return;
+	}
+
+	if( (interval_samples == 0) || (audio.sampling_rate != sampling_rate) ) {
+		sampling_rate = audio.sampling_rate;
+		interval_samples = std::max<size_t>(sampling_rate / rate_hz, 1);
+	}
+
+	size_t i = 0;
+	while( i < audio.count ) {
+		if( capture_count == 0 ) {
+			/* Wait out the interval, and for the idle thread to finish with
+			 * the previous capture.
+			 */
+			const size_t remaining = audio.count - i;
+			if( request_update || (interval_count + remaining <= interval_samples) ) {
+				interval_count = std::min(interval_count + remaining, interval_samples);
+				return;
+			}
+			i += interval_samples - std::min(interval_count, interval_samples);
+			interval_count = 0;
+		}
+
+		/* Store pre-swapped for the FFT: sample m goes to the real (m even) or
+		 * imaginary (m odd) part of complex sample m/2.
+		 */
+		const size_t n = std::min(audio.count - i, real_points - capture_count);
+		for(size_t j=0; j<n; j++) {
+			const size_t m = capture_count + j;
+			const size_t m_rev = __RBIT(m >> 1) >> (32 - log_2(fft_points));
+			const float sample = audio.p[i + j] * scale;
+			if( m & 1 ) {
+				packed[m_rev].imag(sample);
+			} else {
+				packed[m_rev].real(sample);
+			}
+		}
+		capture_count += n;
+		interval_count += n;
+		i += n;
+
+		if( capture_count == real_points ) {
+			capture_count = 0;
+			request_update = true;
+			EventDispatcher::events_flag(EVT_MASK_SPECTRUM);
+		}
+	}
+}
+
+void AudioSpectrumCollector::update() {
+	// Called from idle thread (after EVT_MASK_SPECTRUM is flagged)
+	if( streaming && request_update ) {
+		fft_c_preswapped(packed);
+
+		/* Z = FFT(x[2n] + j x[2n+1]) holds the spectra of the even and odd samples:
+		 * E[k] = (Z[k] + Z*[N-k]) / 2, O[k] = -j (Z[k] - Z*[N-k]) / 2, so
+		 * X[k] = E[k] + W^k O[k] and X[N-k] = (E[k] - W^k O[k])*, W = exp(-j pi / N).
+		 * DC and fs/2 are both real and share packed[0].
+		 */
+		constexpr size_t N = fft_points;
+		const auto z0 = packed[0];
+		packed[0] = { z0.real() + z0.imag(), z0.real() - z0.imag() };
+		packed[N / 2] = std::conj(packed[N / 2]);
+
+		// exp(-j 2 pi / 512) - 1, see fft_c_preswapped().
+		constexpr std::complex<float> wp { -7.529816086e-05f, -0.01227153829f };
+		std::complex<float> w { 1.0f, 0.0f };
+		for(size_t k=1; k<N/2; k++) {
+			w += w * wp;
+			const auto a = packed[k];
+			const auto b = std::conj(packed[N - k]);
+			const auto e = (a + b) * 0.5f;
+			const auto d = (a - b) * 0.5f;
+			const auto wo = w * std::complex<float> { d.imag(), -d.real() };
+			packed[k] = e + wo;
+			packed[N - k] = std::conj(e - wo);
+		}
+
+		const auto bin = [this](const size_t k) -> std::complex<float> {
+			if( k == 0 ) {
+				return { packed[0].real(), 0.0f };
+			} else if( k == N ) {
+				return { packed[0].imag(), 0.0f };
+			} else {
+				return packed[k];
+			}
+		};
+
+		ChannelSpectrum spectrum;
+		spectrum.sampling_rate = sampling_rate;
+		for(size_t i=0; i<spectrum.db.size(); i++) {
+			// Three point Hann window, X[-1] = X*[1].
+			const auto prev = (i == 0) ? std::conj(bin(1)) : bin(i - 1);
+			const auto corrected_sample = bin(i) * 0.5f - (prev + bin(i + 1)) * 0.25f;
+			const auto mag2 = magnitude_squared(corrected_sample);
+			const float db = mag2_to_dbv_norm(mag2);
+			constexpr float mag_scale = 5.0f;
+			const unsigned int v = (db * mag_scale) + 255.0f;
+			spectrum.db[i] = std::max(0U, std::min(255U, v));
+		}
+		fifo.in(spectrum);
+	}
+
+	request_update = false;
+}
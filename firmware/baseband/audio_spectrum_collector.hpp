@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __AUDIO_SPECTRUM_COLLECTOR_H__
+#define __AUDIO_SPECTRUM_COLLECTOR_H__
+
+#include "dsp_types.hpp"
+#include "complex.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+#include "message.hpp"
+
+/* Spectrum of the demodulated audio. 512 real samples are packed as 256
+ * complex samples (even into real, odd into imaginary), transformed with the
+ * same 256-point FFT as the channel spectrum, then split into 256 one-sided
+ * bins from 0 to fs/2.
+ */
+class AudioSpectrumCollector {
+public:
+	void on_message(const Message* const message);
+
+	void feed(const buffer_f32_t& audio);
+	void feed(const buffer_s16_t& audio);
+
+private:
+	static constexpr size_t fft_points = 256;
+	static constexpr size_t real_points = fft_points * 2;
+	static constexpr uint32_t default_rate_hz = 20;
+
+	ChannelSpectrum fifo_data[1 << AudioSpectrumConfigMessage::fifo_k] { };
+	ChannelSpectrumFIFO fifo { fifo_data, AudioSpectrumConfigMessage::fifo_k };
+
+	volatile bool request_update { false };
+	bool streaming { false };
+	uint32_t rate_hz { default_rate_hz };
+	size_t interval_samples { 0 };
+	size_t interval_count { 0 };
+	size_t capture_count { 0 };
+	std::array<std::complex<float>, fft_points> packed { };
+	uint32_t sampling_rate { 0 };
+
+	template<typename T>
+	void feed_samples(const buffer_t<T>& audio, const float scale);
+
+	void set_state(const AudioSpectrumStreamingConfigMessage& message);
+	void start();
+	void stop();
+
+	void update();
+};
+
+#endif/*__AUDIO_SPECTRUM_COLLECTOR_H__*/
@@ -36,6 +36,29 @@ void AudioStatsCollector::consume_audio_buffer(const buffer_f32_t& src) {
 	}
 }
 
+void AudioStatsCollector::consume_audio_buffer(const buffer_s16_t& src) {
+	// Accumulate in integers, convert to full-scale-normalized float once per buffer.
+	uint64_t block_squared_sum = 0;
+	uint32_t block_max_squared = 0;
+	auto src_p = src.p;
+	const auto src_end = &src.p[src.count];
+	while(src_p < src_end) {
+		const int32_t sample = *(src_p++);
+		const uint32_t sample_squared = sample * sample;
+		block_squared_sum += sample_squared;
+		if( sample_squared > block_max_squared ) {
+			block_max_squared = sample_squared;
+		}
+	}
+
+	constexpr float k = 1.0f / (32768.0f * 32768.0f);
+	squared_sum += block_squared_sum * k;
+	const float block_max = block_max_squared * k;
+	if( block_max > max_squared ) {
+		max_squared = block_max;
+	}
+}
+
 bool AudioStatsCollector::update_stats(const size_t sample_count, const size_t sampling_rate) {
 	count += sample_count;
 
@@ -62,6 +85,12 @@ bool AudioStatsCollector::feed(const buffer_f32_t& src) {
 	return update_stats(src.count, src.sampling_rate);
 }
 
+bool AudioStatsCollector::feed(const buffer_s16_t& src) {
+	consume_audio_buffer(src);
+
+	return update_stats(src.count, src.sampling_rate);
+}
+
 bool AudioStatsCollector::mute(const size_t sample_count, const size_t sampling_rate) {
 	return update_stats(sample_count, sampling_rate);
 }
@@ -86,11 +86,6 @@ constexpr gpdma::channel::Config config(const baseband::Direction direction) {
 	};
 }
 
-constexpr size_t buffer_samples_log2n = 13;
-constexpr size_t buffer_samples = (1 << buffer_samples_log2n);
-constexpr size_t transfers_per_buffer_log2n = 2;
-constexpr size_t transfers_per_buffer = (1 << transfers_per_buffer_log2n);
-constexpr size_t transfer_samples = buffer_samples / transfers_per_buffer;
 constexpr size_t transfers_mask = transfers_per_buffer - 1;
 
 constexpr size_t buffer_bytes = buffer_samples * sizeof(baseband::sample_t);
@@ -103,7 +98,10 @@ static constexpr auto& gpdma_channel_sgpio = gpdma::channels[portapack::sgpio_gp
 
 static ThreadWait thread_wait;
 
+static volatile uint32_t transfer_complete_ticks = 0;
+
 static void transfer_complete() {
+	transfer_complete_ticks = halGetCounterValue();
 	const auto next_lli_index = gpdma_channel_sgpio.next_lli() - &lli_loop[0];
 	thread_wait.wake_from_interrupt(next_lli_index);
 }
@@ -170,5 +168,9 @@ baseband::buffer_t wait_for_buffer() {
 	}
 }
 
+uint32_t last_transfer_ticks() {
+	return transfer_complete_ticks;
+}
+
 } /* namespace dma */
 } /* namespace baseband */
@@ -22,6 +22,7 @@
 #ifndef __BASEBAND_DMA_H__
 #define __BASEBAND_DMA_H__
 
+#include <cstdint>
 #include <cstddef>
 #include <array>
 
@@ -31,6 +32,12 @@
 namespace baseband {
 namespace dma {
 
+constexpr size_t buffer_samples_log2n = 13;
+constexpr size_t buffer_samples = (1 << buffer_samples_log2n);
+constexpr size_t transfers_per_buffer_log2n = 2;
+constexpr size_t transfers_per_buffer = (1 << transfers_per_buffer_log2n);
+constexpr size_t transfer_samples = buffer_samples / transfers_per_buffer;
+
 void init();
 void configure(
 	baseband::sample_t* const buffer_base,
@@ -44,6 +51,12 @@ void disable();
 
 baseband::buffer_t wait_for_buffer();
 
+/* Counter value (halGetCounterValue()) at the most recent transfer completion,
+ * i.e. when the newest sample of the buffer returned by wait_for_buffer() was
+ * captured.
+ */
+uint32_t last_transfer_ticks();
+
 } /* namespace dma */
 } /* namespace baseband */
 
@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <array>
+#include <algorithm>
 
 #include "dsp_types.hpp"
 #include "complex.hpp"
@@ -64,6 +65,24 @@ public:
 		return input_sampling_rate() / factor();
 	}
 
+	/* Blocks may be shorter than the N-sample storage. */
+	void set_block_size(const size_t new_block_size) {
+		const auto block_size_clamped = std::min(new_block_size, buffer.size());
+		if( block_size_clamped != block_size() ) {
+			block_size_ = block_size_clamped;
+			reset_state();
+		}
+	}
+
+	size_t block_size() const {
+		return block_size_;
+	}
+
+	/* Drops any partially filled block. */
+	void reset() {
+		reset_state();
+	}
+
 	template<typename BlockCallback>
 	void feed(const buffer_t<T>& src, BlockCallback callback) {
 		/* NOTE: Input block size must be >= factor */
@@ -72,9 +91,9 @@ public:
 
 		while( src_i < src.count ) {
 			buffer[dst_i++] = src.p[src_i];
-			if( dst_i == buffer.size() ) {
-				callback({ buffer.data(), buffer.size(), output_sampling_rate() });
-				reset_state();
+			if( dst_i == block_size_ ) {
+				callback({ buffer.data(), block_size_, output_sampling_rate() });
+				// Keep src_i, the rest of src belongs to the next block.
 				dst_i = 0;
 			}
 
@@ -88,6 +107,7 @@ private:
 	std::array<T, N> buffer { };
 	uint32_t input_sampling_rate_ { 0 };
 	size_t factor_ { 1 };
+	size_t block_size_ { N };
 	size_t src_i { 0 };
 	size_t dst_i { 0 };
 
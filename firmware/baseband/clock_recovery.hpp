@@ -24,9 +24,8 @@
 
 #include <cstddef>
 #include <array>
-#include <functional>
 
-#include "linear_resampler.hpp"
+#include "farrow_resampler.hpp"
 
 namespace clock_recovery {
 
@@ -116,24 +115,14 @@ private:
 template<typename ErrorFilter>
 class ClockRecovery {
 public:
-	using SymbolHandler = std::function<void(const float)>;
-
 	ClockRecovery(
 		const float sampling_rate,
 		const float symbol_rate,
-		ErrorFilter error_filter,
-		SymbolHandler symbol_handler
-	) : symbol_handler { std::move(symbol_handler) }
-	{
+		ErrorFilter error_filter
+	) {
 		configure(sampling_rate, symbol_rate, error_filter);
 	}
 
-	ClockRecovery(
-		SymbolHandler symbol_handler
-	) : symbol_handler { std::move(symbol_handler) }
-	{
-	}
-
 	void configure(
 		const float sampling_rate,
 		const float symbol_rate,
@@ -143,41 +132,34 @@ public:
 		error_filter = error_filter;
 	}
 
+	template<typename SymbolHandler>
 	void operator()(
-		const float baseband_sample
+		const float baseband_sample,
+		SymbolHandler symbol_handler
 	) {
 		resampler(baseband_sample,
-			[this](const float interpolated_sample) {
-				this->resampler_callback(interpolated_sample);
+			[this, &symbol_handler](const float interpolated_sample) {
+				this->resampler_callback(interpolated_sample, symbol_handler);
 			}
 		);
 	}
 
 private:
-	dsp::interpolation::LinearResampler resampler { };
+	dsp::interpolation::FarrowResampler<float> resampler { };
 	GardnerTimingErrorDetector timing_error_detector { };
 	ErrorFilter error_filter { };
-	const SymbolHandler symbol_handler;
 
-	void resampler_callback(const float interpolated_sample) {
+	template<typename SymbolHandler>
+	void resampler_callback(const float interpolated_sample, SymbolHandler& symbol_handler) {
 		timing_error_detector(interpolated_sample,
-			[this](const float symbol, const float lateness) {
-				this->symbol_callback(symbol, lateness);
+			[this, &symbol_handler](const float symbol, const float lateness) {
+				symbol_handler(symbol);
+
+				const float adjustment = this->error_filter(lateness);
+				this->resampler.advance(adjustment);
 			}
 		);
 	}
-
-	void symbol_callback(const float symbol, const float lateness) {
-		// NOTE: This check is to avoid std::function nullptr check, which
-		// brings in "_ZSt25__throw_bad_function_callv" and a lot of extra code.
-		// TODO: Make symbol_handler known at compile time.
-		if( symbol_handler) {
-			symbol_handler(symbol);
-		}
-
-		const float adjustment = error_filter(lateness);
-		resampler.advance(adjustment);
-	}
 };
 
 } /* namespace clock_recovery */
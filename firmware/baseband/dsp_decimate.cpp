@@ -23,171 +23,298 @@
 
 #include <hal.h>
 
+#include <iterator>
+
 namespace dsp {
 namespace decimate {
 
-static inline complex32_t mac_fs4_shift(
-	const vec2_s16* const z,
-	const vec2_s16* const t,
-	const size_t index,
-	const complex32_t accum
+static inline uint32_t scale_round_and_pack(
+	const complex32_t value,
+	const int32_t scale_factor
 ) {
-	/* Accumulate sample * tap results for samples already in z buffer.
-	 * Multiply using swap/negation to achieve Fs/4 shift.
-	 * For iterations where samples are shifting out of z buffer (being discarded).
-	 * Expect negated tap t[2] to accomodate instruction set limitations.
+	/* Multiply 32-bit components of the complex<int32_t> by a scale factor,
+	 * into int64_ts, then round to nearest LSB (1 << 32), saturate to 16 bits,
+	 * and pack into a complex<int16_t>.
 	 */
-	const bool negated_t2 = index & 1;
-	const auto q1_i0 = z[index*2 + 0];
-	const auto i1_q0 = z[index*2 + 1];
-	const auto t1_t0 = t[index];
-	const auto real = negated_t2 ? smlsd(q1_i0, t1_t0, accum.real()) : smlad(q1_i0, t1_t0, accum.real());
-	const auto imag = negated_t2 ? smlad(i1_q0, t1_t0, accum.imag()) : smlsd(i1_q0, t1_t0, accum.imag());
-	return { real, imag };
+	const auto scaled_real = __SMMULR(value.real(), scale_factor);
+	const auto saturated_real = __SSAT(scaled_real, 16);
+
+	const auto scaled_imag = __SMMULR(value.imag(), scale_factor);
+	const auto saturated_imag = __SSAT(scaled_imag, 16);
+
+	return __PKHBT(saturated_real, saturated_imag, 16);
 }
 
-static inline complex32_t mac_shift(
-	const vec2_s16* const z,
-	const vec2_s16* const t,
-	const size_t index,
-	const complex32_t accum
+template<typename Tap>
+static void taps_copy(
+	const Tap* const source,
+	Tap* const target,
+	const size_t count,
+	const bool shift_up
 ) {
-	/* Accumulate sample * tap results for samples already in z buffer.
-	 * For iterations where samples are shifting out of z buffer (being discarded).
-	 * real += i1 * t1 + i0 * t0
-	 * imag += q1 * t1 + q0 * t0
+	const uint32_t negate_pattern = shift_up ? 0b1110 : 0b0100;
+	for(size_t i=0; i<count; i++) {
+		const bool negate = (negate_pattern >> (i & 3)) & 1;
+		target[i] = negate ? -source[i] : source[i];
+	}
+}
+
+/* Real-tap FIR decimators keep their delay line as a ring of taps_count
+ * words (two words per pair of samples), written twice so the window of
+ * the last taps_count samples is always contiguous. Nothing is shifted.
+ *
+ * Symmetric (linear phase) taps are detected by configure(). Each tap word
+ * then serves a pair of samples and, through an exchanged multiply, the
+ * mirrored pair at the other end of the window, halving tap loads.
+ */
+
+template<typename Tap>
+static bool taps_symmetric(
+	const Tap* const taps,
+	const size_t count
+) {
+	return std::equal(&taps[0], &taps[count / 2], std::reverse_iterator<const Tap*>(&taps[count]));
+}
+
+template<typename Tap>
+static void taps_copy_fs4_symmetric(
+	const Tap* const source,
+	Tap* const target,
+	const size_t count,
+	const bool shift_up
+) {
+	/* Negate the second tap of alternate pairs, so the direct and mirrored
+	 * products of each pair can share one accumulate form.
 	 */
-	const auto i1_i0 = z[index*2 + 0];
-	const auto q1_q0 = z[index*2 + 1];
-	const auto t1_t0 = t[index];
-	const auto real = smlad(i1_i0, t1_t0, accum.real());
-	const auto imag = smlad(q1_q0, t1_t0, accum.imag());
-	return { real, imag };
+	taps_copy(source, target, count, shift_up);
+	for(size_t p=0; p<count/4; p++) {
+		if( (p & 1) == shift_up ) {
+			target[p*2+1] = -target[p*2+1];
+		}
+	}
 }
 
-static inline complex32_t mac_fs4_shift_and_store(
+template<size_t TapsCount, size_t DecimationFactor>
+static inline void store_new_c8_samples(
 	vec2_s16* const z,
-	const vec2_s16* const t,
-	const size_t decimation_factor,
-	const size_t index,
-	const complex32_t accum
+	const vec4_s8* const in,
+	const dsp::iq_correction::Coefficients& correction
 ) {
-	/* Accumulate sample * tap results for samples already in z buffer.
-	 * Place new samples into z buffer.
-	 * Expect negated tap t[2] to accomodate instruction set limitations.
+	/* Correct DC offset and IQ imbalance as new samples are unpacked.
+	 * Arrange as q1:i0, i1:q0 pairs for the Fs/4 shift.
 	 */
-	const bool negated_t2 = index & 1;
-	const auto q1_i0 = z[decimation_factor + index*2 + 0];
-	const auto i1_q0 = z[decimation_factor + index*2 + 1];
-	const auto t1_t0 = t[decimation_factor / 2 + index];
-	z[index*2 + 0] = q1_i0;
-	const auto real = negated_t2 ? smlsd(q1_i0, t1_t0, accum.real()) : smlad(q1_i0, t1_t0, accum.real());
-	z[index*2 + 1] = i1_q0;
-	const auto imag = negated_t2 ? smlad(i1_q0, t1_t0, accum.imag()) : smlsd(i1_q0, t1_t0, accum.imag());
-	return { real, imag };
+	for(size_t j=0; j<DecimationFactor/2; j++) {
+		auto i1_i0 = sxtb16(in[j]);
+		auto q1_q0 = sxtb16(in[j], 8);
+		correction.apply(i1_i0.w, q1_q0.w);
+		const auto q1_i0 = pkhbt(i1_i0, q1_q0);
+		const auto i1_q0 = pkhbt(q1_q0, i1_i0);
+		z[j*2 + 0] = q1_i0;
+		z[j*2 + 1] = i1_q0;
+		z[j*2 + 0 + TapsCount] = q1_i0;
+		z[j*2 + 1 + TapsCount] = i1_q0;
+	}
 }
 
-static inline complex32_t mac_shift_and_store(
+template<size_t TapsCount, size_t DecimationFactor>
+static inline void store_new_c16_samples(
 	vec2_s16* const z,
-	const vec2_s16* const t,
-	const size_t decimation_factor,
-	const size_t index,
-	const complex32_t accum
+	const vec2_s16* const in
 ) {
-	/* Accumulate sample * tap results for samples already in z buffer.
-	 * Place new samples into z buffer.
+	/* Arrange as i1:i0, q1:q0 pairs. */
+	for(size_t j=0; j<DecimationFactor/2; j++) {
+		const auto q0_i0 = in[j*2+0];
+		const auto q1_i1 = in[j*2+1];
+		const auto i1_i0 = pkhbt(q0_i0, q1_i1, 16);
+		const auto q1_q0 = pkhtb(q1_i1, q0_i0, 16);
+		z[j*2 + 0] = i1_i0;
+		z[j*2 + 1] = q1_q0;
+		z[j*2 + 0 + TapsCount] = i1_i0;
+		z[j*2 + 1 + TapsCount] = q1_q0;
+	}
+}
+
+enum class FS4Taps {
+	Any,
+	SymmetricDown,
+	SymmetricUp,
+};
+
+template<size_t TapsCount, FS4Taps Taps>
+static inline complex32_t mac_fs4(
+	const vec2_s16* const w,
+	const vec2_s16* const t
+) {
+	/* Multiply using swap/negation to achieve Fs/4 shift.
 	 * Expect negated tap t[2] to accomodate instruction set limitations.
 	 */
-	const auto i1_i0 = z[decimation_factor + index*2 + 0];
-	const auto q1_q0 = z[decimation_factor + index*2 + 1];
-	const auto t1_t0 = t[decimation_factor / 2 + index];
-	z[index*2 + 0] = i1_i0;
-	const auto real = smlad(i1_i0, t1_t0, accum.real());
-	z[index*2 + 1] = q1_q0;
-	const auto imag = smlad(q1_q0, t1_t0, accum.imag());
+	int32_t real = 0;
+	int32_t imag = 0;
+	if( Taps == FS4Taps::Any ) {
+		for(size_t p=0; p<TapsCount/2; p++) {
+			const bool negated_t2 = p & 1;
+			const auto q1_i0 = w[p*2 + 0];
+			const auto i1_q0 = w[p*2 + 1];
+			const auto t1_t0 = t[p];
+			real = negated_t2 ? smlsd(q1_i0, t1_t0, real) : smlad(q1_i0, t1_t0, real);
+			imag = negated_t2 ? smlad(i1_q0, t1_t0, imag) : smlsd(i1_q0, t1_t0, imag);
+		}
+	} else {
+		constexpr bool up = (Taps == FS4Taps::SymmetricUp);
+		for(size_t p=0; p<TapsCount/4; p++) {
+			const size_t m = TapsCount/2 - 1 - p;
+			const auto t1_t0 = t[p];
+			real = up ? smlad(w[p*2 + 0], t1_t0, real) : smlsd(w[p*2 + 0], t1_t0, real);
+			imag = up ? smlsd(w[p*2 + 1], t1_t0, imag) : smlad(w[p*2 + 1], t1_t0, imag);
+			real = up ? smladx(w[m*2 + 0], t1_t0, real) : smlsdx(w[m*2 + 0], t1_t0, real);
+			imag = up ? smlsdx(w[m*2 + 1], t1_t0, imag) : smladx(w[m*2 + 1], t1_t0, imag);
+		}
+	}
 	return { real, imag };
 }
 
-static inline complex32_t mac_fs4_shift_and_store_new_c8_samples(
-	vec2_s16* const z,
-	const vec2_s16* const t,
-	const vec4_s8* const in,
-	const size_t decimation_factor,
-	const size_t index,
-	const size_t length,
-	const complex32_t accum
+template<size_t TapsCount, bool Symmetric>
+static inline complex32_t mac(
+	const vec2_s16* const w,
+	const vec2_s16* const t
 ) {
-	/* Accumulate sample * tap results for new samples.
-	 * Place new samples into z buffer.
-	 * Expect negated tap t[2] to accomodate instruction set limitations.
+	/* real += i1 * t1 + i0 * t0
+	 * imag += q1 * t1 + q0 * t0
 	 */
-	const bool negated_t2 = index & 1;
-	const auto q1_i1_q0_i0 = in[index];
-	const auto t1_t0 = t[(length - decimation_factor) / 2 + index];
-	const auto i1_q1_i0_q0 = rev16(q1_i1_q0_i0);
-	const auto i1_q1_q0_i0 = pkhbt(q1_i1_q0_i0, i1_q1_i0_q0);
-	const auto q1_i0 = sxtb16(i1_q1_q0_i0);
-	const auto i1_q0 = sxtb16(i1_q1_q0_i0, 8);
-	z[length - decimation_factor * 2 + index*2 + 0] = q1_i0;
-	const auto real = negated_t2 ? smlsd(q1_i0, t1_t0, accum.real()) : smlad(q1_i0, t1_t0, accum.real());
-	z[length - decimation_factor * 2 + index*2 + 1] = i1_q0;
-	const auto imag = negated_t2 ? smlad(i1_q0, t1_t0, accum.imag()) : smlsd(i1_q0, t1_t0, accum.imag());
+	int32_t real = 0;
+	int32_t imag = 0;
+	if( !Symmetric ) {
+		for(size_t p=0; p<TapsCount/2; p++) {
+			real = smlad(w[p*2 + 0], t[p], real);
+			imag = smlad(w[p*2 + 1], t[p], imag);
+		}
+	} else {
+		for(size_t p=0; p<TapsCount/4; p++) {
+			const size_t m = TapsCount/2 - 1 - p;
+			const auto t1_t0 = t[p];
+			real = smlad(w[p*2 + 0], t1_t0, real);
+			imag = smlad(w[p*2 + 1], t1_t0, imag);
+			real = smladx(w[m*2 + 0], t1_t0, real);
+			imag = smladx(w[m*2 + 1], t1_t0, imag);
+		}
+	}
 	return { real, imag };
 }
 
-static inline complex32_t mac_shift_and_store_new_c16_samples(
+template<size_t TapsCount, size_t DecimationFactor, FS4Taps Taps>
+static buffer_c16_t fir_c8_fs4_decimate(
+	const buffer_c8_t& src,
+	const buffer_c16_t& dst,
 	vec2_s16* const z,
+	size_t& z_pos,
 	const vec2_s16* const t,
-	const vec2_s16* const in,
-	const size_t decimation_factor,
-	const size_t index,
-	const size_t length,
-	const complex32_t accum
+	const int32_t scale,
+	const dsp::iq_correction::Coefficients& correction
 ) {
-	/* Accumulate sample * tap results for new samples.
-	 * Place new samples into z buffer.
-	 * Expect negated tap t[2] to accomodate instruction set limitations.
-	 */
-	const auto q0_i0 = in[index*2+0];
-	const auto q1_i1 = in[index*2+1];
-	const auto i1_i0 = pkhbt(q0_i0, q1_i1, 16);
-	const auto q1_q0 = pkhtb(q1_i1, q0_i0, 16);
-	const auto t1_t0 = t[(length - decimation_factor) / 2 + index];
-	z[length - decimation_factor * 2 + index*2 + 0] = i1_i0;
-	const auto real = smlad(i1_i0, t1_t0, accum.real());
-	z[length - decimation_factor * 2 + index*2 + 1] = q1_q0;
-	const auto imag = smlad(q1_q0, t1_t0, accum.imag());
-	return { real, imag };
+	static_assert((TapsCount % 4) == 0, "Taps count must be a multiple of 4");
+	static_assert((TapsCount % DecimationFactor) == 0, "Taps count must be a multiple of the decimation factor");
+
+	uint32_t* const d = static_cast<uint32_t*>(__builtin_assume_aligned(dst.p, 4));
+
+	size_t pos = z_pos;
+	const size_t count = src.count / DecimationFactor;
+	for(size_t i=0; i<count; i++) {
+		const vec4_s8* const in = static_cast<const vec4_s8*>(__builtin_assume_aligned(&src.p[i * DecimationFactor], 4));
+
+		// Newest samples come from "in" buffer, go to both copies of the ring.
+		store_new_c8_samples<TapsCount, DecimationFactor>(&z[pos], in, correction);
+
+		const auto accum = mac_fs4<TapsCount, Taps>(&z[pos + DecimationFactor], t);
+		d[i] = scale_round_and_pack(accum, scale);
+
+		pos += DecimationFactor;
+		if( pos == TapsCount ) {
+			pos = 0;
+		}
+	}
+	z_pos = pos;
+
+	return {
+		dst.p,
+		count,
+		src.sampling_rate / DecimationFactor
+	};
 }
 
-static inline uint32_t scale_round_and_pack(
-	const complex32_t value,
-	const int32_t scale_factor
+template<size_t TapsCount, size_t DecimationFactor, bool Symmetric>
+static buffer_c16_t fir_c16_decimate(
+	const buffer_c16_t& src,
+	const buffer_c16_t& dst,
+	vec2_s16* const z,
+	size_t& z_pos,
+	const vec2_s16* const t,
+	const int32_t scale
 ) {
-	/* Multiply 32-bit components of the complex<int32_t> by a scale factor,
-	 * into int64_ts, then round to nearest LSB (1 << 32), saturate to 16 bits,
-	 * and pack into a complex<int16_t>.
-	 */
-	const auto scaled_real = __SMMULR(value.real(), scale_factor);
-	const auto saturated_real = __SSAT(scaled_real, 16);
+	static_assert((TapsCount % 4) == 0, "Taps count must be a multiple of 4");
+	static_assert((TapsCount % DecimationFactor) == 0, "Taps count must be a multiple of the decimation factor");
 
-	const auto scaled_imag = __SMMULR(value.imag(), scale_factor);
-	const auto saturated_imag = __SSAT(scaled_imag, 16);
+	uint32_t* const d = static_cast<uint32_t*>(__builtin_assume_aligned(dst.p, 4));
 
-	return __PKHBT(saturated_real, saturated_imag, 16);
+	size_t pos = z_pos;
+	const size_t count = src.count / DecimationFactor;
+	for(size_t i=0; i<count; i++) {
+		const vec2_s16* const in = static_cast<const vec2_s16*>(__builtin_assume_aligned(&src.p[i * DecimationFactor], 4));
+
+		// Newest samples come from "in" buffer, go to both copies of the ring.
+		store_new_c16_samples<TapsCount, DecimationFactor>(&z[pos], in);
+
+		const auto accum = mac<TapsCount, Symmetric>(&z[pos + DecimationFactor], t);
+		d[i] = scale_round_and_pack(accum, scale);
+
+		pos += DecimationFactor;
+		if( pos == TapsCount ) {
+			pos = 0;
+		}
+	}
+	z_pos = pos;
+
+	return {
+		dst.p,
+		count,
+		src.sampling_rate / DecimationFactor
+	};
 }
 
-template<typename Tap>
-static void taps_copy(
-	const Tap* const source,
-	Tap* const target,
-	const size_t count,
+template<size_t TapsCount, size_t DecimationFactor>
+static buffer_c16_t fir_c8_fs4_decimate(
+	const buffer_c8_t& src,
+	const buffer_c16_t& dst,
+	vec2_s16* const z,
+	size_t& z_pos,
+	const vec2_s16* const t,
+	const int32_t scale,
+	const dsp::iq_correction::Coefficients& correction,
+	const bool symmetric,
 	const bool shift_up
 ) {
-	const uint32_t negate_pattern = shift_up ? 0b1110 : 0b0100;
-	for(size_t i=0; i<count; i++) {
-		const bool negate = (negate_pattern >> (i & 3)) & 1;
-		target[i] = negate ? -source[i] : source[i];
+	if( !symmetric ) {
+		return fir_c8_fs4_decimate<TapsCount, DecimationFactor, FS4Taps::Any>(src, dst, z, z_pos, t, scale, correction);
+	} else if( shift_up ) {
+		return fir_c8_fs4_decimate<TapsCount, DecimationFactor, FS4Taps::SymmetricUp>(src, dst, z, z_pos, t, scale, correction);
+	} else {
+		return fir_c8_fs4_decimate<TapsCount, DecimationFactor, FS4Taps::SymmetricDown>(src, dst, z, z_pos, t, scale, correction);
+	}
+}
+
+template<size_t TapsCount, size_t DecimationFactor>
+static buffer_c16_t fir_c16_decimate(
+	const buffer_c16_t& src,
+	const buffer_c16_t& dst,
+	vec2_s16* const z,
+	size_t& z_pos,
+	const vec2_s16* const t,
+	const int32_t scale,
+	const bool symmetric
+) {
+	if( symmetric ) {
+		return fir_c16_decimate<TapsCount, DecimationFactor, true>(src, dst, z, z_pos, t, scale);
+	} else {
+		return fir_c16_decimate<TapsCount, DecimationFactor, false>(src, dst, z, z_pos, t, scale);
 	}
 }
 
@@ -198,9 +325,16 @@ void FIRC8xR16x24FS4Decim4::configure(
 	const int32_t scale,
 	const Shift shift
 ) {
-	taps_copy(taps.data(), taps_.data(), taps_.size(), shift == Shift::Up);
+	symmetric_ = taps_symmetric(taps.data(), taps.size());
+	shift_up_ = (shift == Shift::Up);
+	if( symmetric_ ) {
+		taps_copy_fs4_symmetric(taps.data(), taps_.data(), taps_.size(), shift_up_);
+	} else {
+		taps_copy(taps.data(), taps_.data(), taps_.size(), shift_up_);
+	}
 	output_scale = scale;
 	z_.fill({});
+	z_pos_ = 0;
 }
 
 buffer_c16_t FIRC8xR16x24FS4Decim4::execute(
@@ -209,42 +343,13 @@ buffer_c16_t FIRC8xR16x24FS4Decim4::execute(
 ) {
 	vec2_s16* const z = static_cast<vec2_s16*>(__builtin_assume_aligned(z_.data(), 4));
 	const vec2_s16* const t = static_cast<vec2_s16*>(__builtin_assume_aligned(taps_.data(), 4));
-	uint32_t* const d = static_cast<uint32_t*>(__builtin_assume_aligned(dst.p, 4));
-
-	const auto k = output_scale;
-
-	const size_t count = src.count / decimation_factor;
-	for(size_t i=0; i<count; i++) {
-		const vec4_s8* const in = static_cast<const vec4_s8*>(__builtin_assume_aligned(&src.p[i * decimation_factor], 4));
-
-		complex32_t accum;
-
-		// Oldest samples are discarded.
-		accum = mac_fs4_shift(z, t, 0, accum);
-		accum = mac_fs4_shift(z, t, 1, accum);
 
-		// Middle samples are shifted earlier in the "z" delay buffer.
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 0, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 1, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 2, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 3, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 4, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 5, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 6, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 7, accum);
-
-		// Newest samples come from "in" buffer, are copied to "z" delay buffer.
-		accum = mac_fs4_shift_and_store_new_c8_samples(z, t, in, decimation_factor, 0, taps_count, accum);
-		accum = mac_fs4_shift_and_store_new_c8_samples(z, t, in, decimation_factor, 1, taps_count, accum);
-
-		d[i] = scale_round_and_pack(accum, k);
-	}
+	iq_correction.update(src);
+	const auto correction = iq_correction.coefficients();
 
-	return {
-		dst.p,
-		count,
-		src.sampling_rate / decimation_factor
-	};
+	return fir_c8_fs4_decimate<taps_count, decimation_factor>(
+		src, dst, z, z_pos_, t, output_scale, correction, symmetric_, shift_up_
+	);
 }
 
 // FIRC8xR16x24FS4Decim8 //////////////////////////////////////////////////
@@ -254,9 +359,16 @@ void FIRC8xR16x24FS4Decim8::configure(
 	const int32_t scale,
 	const Shift shift
 ) {
-	taps_copy(taps.data(), taps_.data(), taps_.size(), shift == Shift::Up);
+	symmetric_ = taps_symmetric(taps.data(), taps.size());
+	shift_up_ = (shift == Shift::Up);
+	if( symmetric_ ) {
+		taps_copy_fs4_symmetric(taps.data(), taps_.data(), taps_.size(), shift_up_);
+	} else {
+		taps_copy(taps.data(), taps_.data(), taps_.size(), shift_up_);
+	}
 	output_scale = scale;
 	z_.fill({});
+	z_pos_ = 0;
 }
 
 buffer_c16_t FIRC8xR16x24FS4Decim8::execute(
@@ -265,42 +377,13 @@ buffer_c16_t FIRC8xR16x24FS4Decim8::execute(
 ) {
 	vec2_s16* const z = static_cast<vec2_s16*>(__builtin_assume_aligned(z_.data(), 4));
 	const vec2_s16* const t = static_cast<vec2_s16*>(__builtin_assume_aligned(taps_.data(), 4));
-	uint32_t* const d = static_cast<uint32_t*>(__builtin_assume_aligned(dst.p, 4));
 
-	const auto k = output_scale;
+	iq_correction.update(src);
+	const auto correction = iq_correction.coefficients();
 
-	const size_t count = src.count / decimation_factor;
-	for(size_t i=0; i<count; i++) {
-		const vec4_s8* const in = static_cast<const vec4_s8*>(__builtin_assume_aligned(&src.p[i * decimation_factor], 4));
-
-		complex32_t accum;
-
-		// Oldest samples are discarded.
-		accum = mac_fs4_shift(z, t, 0, accum);
-		accum = mac_fs4_shift(z, t, 1, accum);
-		accum = mac_fs4_shift(z, t, 2, accum);
-		accum = mac_fs4_shift(z, t, 3, accum);
-
-		// Middle samples are shifted earlier in the "z" delay buffer.
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 0, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 1, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 2, accum);
-		accum = mac_fs4_shift_and_store(z, t, decimation_factor, 3, accum);
-
-		// Newest samples come from "in" buffer, are copied to "z" delay buffer.
-		accum = mac_fs4_shift_and_store_new_c8_samples(z, t, in, decimation_factor, 0, taps_count, accum);
-		accum = mac_fs4_shift_and_store_new_c8_samples(z, t, in, decimation_factor, 1, taps_count, accum);
-		accum = mac_fs4_shift_and_store_new_c8_samples(z, t, in, decimation_factor, 2, taps_count, accum);
-		accum = mac_fs4_shift_and_store_new_c8_samples(z, t, in, decimation_factor, 3, taps_count, accum);
-
-		d[i] = scale_round_and_pack(accum, k);
-	}
-
-	return {
-		dst.p,
-		count,
-		src.sampling_rate / decimation_factor
-	};
+	return fir_c8_fs4_decimate<taps_count, decimation_factor>(
+		src, dst, z, z_pos_, t, output_scale, correction, symmetric_, shift_up_
+	);
 }
 
 // FIRC16xR16x16Decim2 ////////////////////////////////////////////////////
@@ -309,9 +392,11 @@ void FIRC16xR16x16Decim2::configure(
 	const std::array<tap_t, taps_count>& taps,
 	const int32_t scale
 ) {
+	symmetric_ = taps_symmetric(taps.data(), taps.size());
 	std::copy(taps.cbegin(), taps.cend(), taps_.begin());
 	output_scale = scale;
 	z_.fill({});
+	z_pos_ = 0;
 }
 
 buffer_c16_t FIRC16xR16x16Decim2::execute(
@@ -320,38 +405,10 @@ buffer_c16_t FIRC16xR16x16Decim2::execute(
 ) {
 	vec2_s16* const z = static_cast<vec2_s16*>(__builtin_assume_aligned(z_.data(), 4));
 	const vec2_s16* const t = static_cast<vec2_s16*>(__builtin_assume_aligned(taps_.data(), 4));
-	uint32_t* const d = static_cast<uint32_t*>(__builtin_assume_aligned(dst.p, 4));
-
-	const auto k = output_scale;
-
-	const size_t count = src.count / decimation_factor;
-	for(size_t i=0; i<count; i++) {
-		const vec2_s16* const in = static_cast<const vec2_s16*>(__builtin_assume_aligned(&src.p[i * decimation_factor], 4));
-
-		complex32_t accum;
-
-		// Oldest samples are discarded.
-		accum = mac_shift(z, t, 0, accum);
 
-		// Middle samples are shifted earlier in the "z" delay buffer.
-		accum = mac_shift_and_store(z, t, decimation_factor, 0, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 1, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 2, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 3, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 4, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 5, accum);
-
-		// Newest samples come from "in" buffer, are copied to "z" delay buffer.
-		accum = mac_shift_and_store_new_c16_samples(z, t, in, decimation_factor, 0, taps_count, accum);
-
-		d[i] = scale_round_and_pack(accum, k);
-	}
-
-	return {
-		dst.p,
-		count,
-		src.sampling_rate / decimation_factor
-	};
+	return fir_c16_decimate<taps_count, decimation_factor>(
+		src, dst, z, z_pos_, t, output_scale, symmetric_
+	);
 }
 
 // FIRC16xR16x32Decim8 ////////////////////////////////////////////////////
@@ -360,9 +417,11 @@ void FIRC16xR16x32Decim8::configure(
 	const std::array<tap_t, taps_count>& taps,
 	const int32_t scale
 ) {
+	symmetric_ = taps_symmetric(taps.data(), taps.size());
 	std::copy(taps.cbegin(), taps.cend(), taps_.begin());
 	output_scale = scale;
 	z_.fill({});
+	z_pos_ = 0;
 }
 
 buffer_c16_t FIRC16xR16x32Decim8::execute(
@@ -371,46 +430,10 @@ buffer_c16_t FIRC16xR16x32Decim8::execute(
 ) {
 	vec2_s16* const z = static_cast<vec2_s16*>(__builtin_assume_aligned(z_.data(), 4));
 	const vec2_s16* const t = static_cast<vec2_s16*>(__builtin_assume_aligned(taps_.data(), 4));
-	uint32_t* const d = static_cast<uint32_t*>(__builtin_assume_aligned(dst.p, 4));
 
-	const auto k = output_scale;
-
-	const size_t count = src.count / decimation_factor;
-	for(size_t i=0; i<count; i++) {
-		const vec2_s16* const in = static_cast<const vec2_s16*>(__builtin_assume_aligned(&src.p[i * decimation_factor], 4));
-
-		complex32_t accum;
-
-		// Oldest samples are discarded.
-		accum = mac_shift(z, t, 0, accum);
-		accum = mac_shift(z, t, 1, accum);
-		accum = mac_shift(z, t, 2, accum);
-		accum = mac_shift(z, t, 3, accum);
-
-		// Middle samples are shifted earlier in the "z" delay buffer.
-		accum = mac_shift_and_store(z, t, decimation_factor, 0, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 1, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 2, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 3, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 4, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 5, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 6, accum);
-		accum = mac_shift_and_store(z, t, decimation_factor, 7, accum);
-
-		// Newest samples come from "in" buffer, are copied to "z" delay buffer.
-		accum = mac_shift_and_store_new_c16_samples(z, t, in, decimation_factor, 0, taps_count, accum);
-		accum = mac_shift_and_store_new_c16_samples(z, t, in, decimation_factor, 1, taps_count, accum);
-		accum = mac_shift_and_store_new_c16_samples(z, t, in, decimation_factor, 2, taps_count, accum);
-		accum = mac_shift_and_store_new_c16_samples(z, t, in, decimation_factor, 3, taps_count, accum);
-
-		d[i] = scale_round_and_pack(accum, k);
-	}
-
-	return {
-		dst.p,
-		count,
-		src.sampling_rate / decimation_factor
-	};
+	return fir_c16_decimate<taps_count, decimation_factor>(
+		src, dst, z, z_pos_, t, output_scale, symmetric_
+	);
 }
 
 buffer_c16_t Complex8DecimateBy2CIC3::execute(const buffer_c8_t& src, const buffer_c16_t& dst) {
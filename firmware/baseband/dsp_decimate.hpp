@@ -33,6 +33,8 @@
 
 #include "simd.hpp"
 
+#include "dsp_iq_correction.hpp"
+
 namespace dsp {
 namespace decimate {
 
@@ -115,9 +117,13 @@ public:
 	);
 	
 private:
-	std::array<vec2_s16, taps_count - decimation_factor> z_ { };
+	std::array<vec2_s16, taps_count * 2> z_ { };
+	size_t z_pos_ { 0 };
 	std::array<tap_t, taps_count> taps_ { };
 	int32_t output_scale = 0;
+	bool symmetric_ { false };
+	bool shift_up_ { false };
+	dsp::iq_correction::IQCorrection iq_correction { };
 };
 
 class FIRC8xR16x24FS4Decim8 {
@@ -145,9 +151,13 @@ public:
 	);
 	
 private:
-	std::array<vec2_s16, taps_count - decimation_factor> z_ { };
+	std::array<vec2_s16, taps_count * 2> z_ { };
+	size_t z_pos_ { 0 };
 	std::array<tap_t, taps_count> taps_ { };
 	int32_t output_scale = 0;
+	bool symmetric_ { false };
+	bool shift_up_ { false };
+	dsp::iq_correction::IQCorrection iq_correction { };
 };
 
 class FIRC16xR16x16Decim2 {
@@ -169,9 +179,11 @@ public:
 	);
 	
 private:
-	std::array<vec2_s16, taps_count - decimation_factor> z_ { };
+	std::array<vec2_s16, taps_count * 2> z_ { };
+	size_t z_pos_ { 0 };
 	std::array<tap_t, taps_count> taps_ { };
 	int32_t output_scale = 0;
+	bool symmetric_ { false };
 };
 
 class FIRC16xR16x32Decim8 {
@@ -193,9 +205,11 @@ public:
 	);
 	
 private:
-	std::array<vec2_s16, taps_count - decimation_factor> z_ { };
+	std::array<vec2_s16, taps_count * 2> z_ { };
+	size_t z_pos_ { 0 };
 	std::array<tap_t, taps_count> taps_ { };
 	int32_t output_scale = 0;
+	bool symmetric_ { false };
 };
 
 class FIRAndDecimateComplex {
@@ -24,9 +24,13 @@
 #include "complex.hpp"
 #include "fxpt_atan2.hpp"
 #include "utility_m4.hpp"
+#include "sine_table.hpp"
 
 #include <hal.h>
 
+#include <algorithm>
+#include <cstdlib>
+
 namespace dsp {
 namespace demodulate {
 
@@ -65,28 +69,189 @@ buffer_f32_t SSB::execute(
 
 	return { dst.p, src.count, src.sampling_rate };
 }
-/*
-static inline float angle_approx_4deg0(const complex32_t t) {
-	const auto x = static_cast<float>(t.imag()) / static_cast<float>(t.real());
-	return 16384.0f * x;
-}
-*/
-static inline float angle_approx_0deg27(const complex32_t t) {
-	if( t.real() ) {
-		const auto x = static_cast<float>(t.imag()) / static_cast<float>(t.real());
-		return x / (1.0f + 0.28086f * x * x);
-	} else {
-		return (t.imag() < 0) ? -1.5707963268f : 1.5707963268f;
+namespace {
+
+constexpr sine_table_rotation_q15_t rotation_table = make_sine_table_rotation_q15();
+
+} /* namespace */
+
+buffer_f32_t SAM::execute(
+	const buffer_c16_t& src,
+	const buffer_f32_t& dst
+) {
+	/* Round to the nearest table entry rather than truncating. */
+	constexpr uint32_t phase_round = 1U << (31 - sine_table_f32_period_log2);
+
+	auto phase = phase_;
+	auto frequency = frequency_;
+	const auto frequency_max = frequency_max_;
+	const auto gains = locked() ? track_ : acquire_;
+	const auto error_scale = error_scale_;
+
+	int32_t in_phase_sum = 0;
+	uint32_t magnitude_sum = 0;
+
+	const auto src_p = src.p;
+	const auto src_end = &src.p[src.count];
+	auto dst_p = dst.p;
+	while(src_p < src_end) {
+		const uint32_t sample = *__SIMD32(src_p)++;
+		const uint32_t sin_cos = rotation_table.w[(phase + phase_round) >> (32 - sine_table_f32_period_log2)];
+
+		// Rotate by -phase: in-phase = i * cos + q * sin, quadrature = q * cos - i * sin
+		const int32_t in_phase = __SMUAD(sample, sin_cos) >> 15;
+		const int32_t quadrature = -(static_cast<int32_t>(__SMUSDX(sample, sin_cos)) >> 15);
+
+		// Phase error, Q15 radians, clamped to +/-1.
+		const int32_t error = __SSAT(static_cast<int32_t>((static_cast<int64_t>(quadrature) * error_scale) >> 15), 16);
+
+		frequency = std::max(-frequency_max, std::min(frequency + gains.ki * error, frequency_max));
+		phase += frequency + gains.kp * error;
+
+		in_phase_sum += in_phase;
+		magnitude_sum += (in_phase < 0) ? -in_phase : in_phase;
+		*(dst_p++) = in_phase * k;
 	}
+	phase_ = phase;
+	frequency_ = frequency;
+
+	/* Normalize the phase detector by the average carrier amplitude, so loop
+	 * bandwidth doesn't follow signal level. Below an amplitude of 64, let
+	 * the gain fall off rather than chase noise.
+	 */
+	const uint32_t magnitude_average = src.count ? (magnitude_sum / src.count) : 0;
+	error_scale_ = (1 << 30) / std::max<uint32_t>(magnitude_average, 64);
+
+	/* Locked when the projection stays mostly on the positive (carrier)
+	 * side, which still holds through overmodulation or a faded carrier.
+	 * An unlocked loop spins, and in-phase averages out.
+	 */
+	const bool in_lock = (in_phase_sum > 0) && (static_cast<uint32_t>(in_phase_sum) > (magnitude_sum >> 1));
+	lock_count_ = std::max<int32_t>(0, std::min<int32_t>(lock_count_ + (in_lock ? 1 : -1), lock_count_max));
+
+	return { dst.p, src.count, src.sampling_rate };
+}
+
+SAM::LoopGains SAM::loop_gains(
+	const float sampling_rate,
+	const float natural_frequency_hz
+) {
+	/* Second order loop, damping 0.707. Phase is 2^32 per turn, phase error
+	 * is Q15 radians.
+	 */
+	constexpr float damping = 0.707f;
+	constexpr float phase_per_radian = 4294967296.0f / (2.0f * pi);
+	constexpr float phase_per_error = phase_per_radian / 32768.0f;
+
+	const float wn_t = 2.0f * pi * natural_frequency_hz / sampling_rate;
+	return {
+		static_cast<int32_t>(2.0f * damping * wn_t * phase_per_error + 0.5f),
+		std::max<int32_t>(1, static_cast<int32_t>(wn_t * wn_t * phase_per_error + 0.5f))
+	};
+}
+
+void SAM::configure(
+	const float sampling_rate,
+	const float loop_natural_frequency_hz,
+	const float max_carrier_offset_hz
+) {
+	track_ = loop_gains(sampling_rate, loop_natural_frequency_hz);
+	acquire_ = loop_gains(sampling_rate, loop_natural_frequency_hz * acquire_bandwidth_factor);
+
+	frequency_max_ = static_cast<int32_t>(max_carrier_offset_hz / sampling_rate * 4294967296.0f);
+	sampling_rate_ = sampling_rate;
+
+	phase_ = 0;
+	frequency_ = 0;
+	error_scale_ = (1 << 30) / 64;
+	lock_count_ = 0;
+}
+
+float SAM::carrier_offset_hz() const {
+	return frequency_ * (sampling_rate_ / 4294967296.0f);
+}
+
+bool SAM::locked() const {
+	return lock_count_ >= (lock_count_max / 2);
 }
 
+/* FM discriminators. Error is the worst case over all angles, measured
+ * against atan2() on a host. Cycle counts are per sample, estimated from
+ * Cortex-M4F instruction timings, and exclude the conjugate multiply and
+ * output scaling common to all of them.
+ *
+ *                        error (rad)                   cycles
+ * angle_precise          ~1e-7                         ~150 (newlib atan2f)
+ * angle_polynomial       1e-5                          ~40  (one VDIV)
+ * angle_cross_product    dtheta - sin(dtheta)          ~25  (one VDIV)
+ * fxpt_atan2 (fixed)     3.8e-3                        ~30  (one SDIV)
+ * cross_product_q15      dtheta - sin(dtheta) + 2^-15  ~20  (one SDIV)
+ *
+ * The cross product discriminator compresses large phase steps: 1% at
+ * 0.25 rad, 4% at 0.5 rad, 16% at 1 rad. Keep it to signals where
+ * 2 * pi * deviation / sampling_rate stays small.
+ */
+
 static inline float angle_precise(const complex32_t t) {
 	return atan2f(t.imag(), t.real());
 }
 
-buffer_f32_t FM::execute(
+static inline float angle_polynomial(const complex32_t t) {
+	/* Fold into the first octant, approximate atan() on [0, 1] with
+	 * Abramowitz & Stegun 4.4.49, unfold.
+	 */
+	const float x = t.real();
+	const float y = t.imag();
+	const float ax = std::abs(x);
+	const float ay = std::abs(y);
+	const bool swap = ay > ax;
+	const float num = swap ? ax : ay;
+	const float den = swap ? ay : ax;
+	if( den == 0.0f ) {
+		return 0.0f;
+	}
+	const float r = num / den;
+	const float r2 = r * r;
+	float a = r * (0.9998660f + r2 * (-0.3302995f + r2 * (0.1801410f + r2 * (-0.0851330f + r2 * 0.0208351f))));
+	if( swap ) {
+		a = (pi / 2) - a;
+	}
+	if( x < 0.0f ) {
+		a = pi - a;
+	}
+	return (y < 0.0f) ? -a : a;
+}
+
+static inline float angle_cross_product(const complex32_t t, const uint32_t mag_sq) {
+	// sin(dtheta) ~= (I[n] * Q[n-1] - Q[n] * I[n-1]) / |s[n]|^2
+	return mag_sq ? (static_cast<float>(t.imag()) / static_cast<float>(mag_sq)) : 0.0f;
+}
+
+static inline int32_t angle_fxpt_atan2(const complex32_t t) {
+	/* Normalize to 16 bits for fxpt_atan2(). Returns -32768 to 32767 for -pi to pi. */
+	const uint32_t m = static_cast<uint32_t>(std::abs(t.real())) | static_cast<uint32_t>(std::abs(t.imag()));
+	const int32_t shift = std::max<int32_t>(0, 17 - __CLZ(m));
+	return fxpt_atan2(t.imag() >> shift, t.real() >> shift);
+}
+
+static inline int32_t cross_product_q15(const complex32_t t, const uint32_t mag_sq) {
+	/* sin(dtheta) in Q15. Drop two bits so the normalizing shift below
+	 * always has headroom, then normalize the divisor to at least 14 bits.
+	 */
+	const int32_t mag = mag_sq >> 2;
+	if( mag == 0 ) {
+		return 0;
+	}
+	const int32_t im = std::max(-mag, std::min(t.imag() >> 2, mag));
+	const int32_t a = std::min<int32_t>(15, __CLZ(mag) - 2);
+	return (im << a) / (mag >> (15 - a));
+}
+
+template<typename Discriminate>
+buffer_f32_t FM::execute_f32(
 	const buffer_c16_t& src,
-	const buffer_f32_t& dst
+	const buffer_f32_t& dst,
+	Discriminate discriminate
 ) {
 	auto z = z_;
 
@@ -99,17 +264,19 @@ buffer_f32_t FM::execute(
 		const auto t0 = multiply_conjugate_s16_s32(s0, z);
 		const auto t1 = multiply_conjugate_s16_s32(s1, s0);
 		z = s1;
-		*(dst_p++) = angle_precise(t0) * kf;
-		*(dst_p++) = angle_precise(t1) * kf;
+		*(dst_p++) = discriminate(t0, s0) * kf;
+		*(dst_p++) = discriminate(t1, s1) * kf;
 	}
 	z_ = z;
 
 	return { dst.p, src.count, src.sampling_rate };
 }
 
-buffer_s16_t FM::execute(
+template<typename Discriminate>
+buffer_s16_t FM::execute_s16(
 	const buffer_c16_t& src,
-	const buffer_s16_t& dst
+	const buffer_s16_t& dst,
+	Discriminate discriminate
 ) {
 	auto z = z_;
 
@@ -122,9 +289,9 @@ buffer_s16_t FM::execute(
 		const auto t0 = multiply_conjugate_s16_s32(s0, z);
 		const auto t1 = multiply_conjugate_s16_s32(s1, s0);
 		z = s1;
-		const int32_t theta0_int = angle_approx_0deg27(t0) * ks16;
+		const int32_t theta0_int = discriminate(t0, s0);
 		const int32_t theta0_sat = __SSAT(theta0_int, 16);
-		const int32_t theta1_int = angle_approx_0deg27(t1) * ks16;
+		const int32_t theta1_int = discriminate(t1, s1);
 		const int32_t theta1_sat = __SSAT(theta1_int, 16);
 		*__SIMD32(dst_p)++ = __PKHBT(
 			theta0_sat,
@@ -137,7 +304,57 @@ buffer_s16_t FM::execute(
 	return { dst.p, src.count, src.sampling_rate };
 }
 
-void FM::configure(const float sampling_rate, const float deviation_hz) {
+buffer_f32_t FM::execute(
+	const buffer_c16_t& src,
+	const buffer_f32_t& dst
+) {
+	switch(discriminator_) {
+	case Discriminator::Atan2:
+		return execute_f32(src, dst, [](const complex32_t t, const uint32_t) {
+			return angle_precise(t);
+		});
+
+	case Discriminator::CrossProduct:
+		return execute_f32(src, dst, [](const complex32_t t, const uint32_t s) {
+			return angle_cross_product(t, __SMUAD(s, s));
+		});
+
+	case Discriminator::Polynomial:
+	default:
+		return execute_f32(src, dst, [](const complex32_t t, const uint32_t) {
+			return angle_polynomial(t);
+		});
+	}
+}
+
+buffer_s16_t FM::execute(
+	const buffer_c16_t& src,
+	const buffer_s16_t& dst
+) {
+	switch(discriminator_) {
+	case Discriminator::Atan2:
+		return execute_s16(src, dst, [this](const complex32_t t, const uint32_t) {
+			return static_cast<int32_t>(angle_precise(t) * ks16);
+		});
+
+	case Discriminator::CrossProduct:
+		return execute_s16(src, dst, [this](const complex32_t t, const uint32_t s) {
+			return static_cast<int32_t>((cross_product_q15(t, __SMUAD(s, s)) * ks16_q15) >> 15);
+		});
+
+	case Discriminator::Polynomial:
+	default:
+		return execute_s16(src, dst, [this](const complex32_t t, const uint32_t) {
+			return static_cast<int32_t>((angle_fxpt_atan2(t) * ks16_fxpt_atan2) >> 15);
+		});
+	}
+}
+
+void FM::configure(
+	const float sampling_rate,
+	const float deviation_hz,
+	const Discriminator discriminator
+) {
 	/*
 	 * angle: -pi to pi. output range: -32768 to 32767.
 	 * Maximum delta-theta (output of atan2) at maximum deviation frequency:
@@ -145,6 +362,12 @@ void FM::configure(const float sampling_rate, const float deviation_hz) {
 	 */
 	kf = static_cast<float>(1.0f / (2.0 * pi * deviation_hz / sampling_rate));
 	ks16 = 32767.0f * kf;
+
+	// fxpt_atan2() units are pi / 32768 radians, cross_product_q15() units 1 / 32768.
+	ks16_fxpt_atan2 = static_cast<int64_t>(ks16 * pi);
+	ks16_q15 = static_cast<int64_t>(ks16);
+
+	discriminator_ = discriminator;
 }
 
 }
@@ -24,6 +24,8 @@
 
 #include "dsp_types.hpp"
 
+#include <cstdint>
+
 namespace dsp {
 namespace demodulate {
 
@@ -49,8 +51,63 @@ private:
 	static constexpr float k = 1.0f / 32768.0f;
 };
 
+class SAM {
+public:
+	/* Synchronous AM: a PLL tracks the carrier and the channel is projected
+	 * onto the recovered carrier phase. Fixed point, running at the channel
+	 * rate, with the phase detector gain and lock state updated once per
+	 * buffer. The loop widens until it locks, to pull in carrier offsets
+	 * well beyond its tracking bandwidth.
+	 */
+	buffer_f32_t execute(
+		const buffer_c16_t& src,
+		const buffer_f32_t& dst
+	);
+
+	void configure(
+		const float sampling_rate,
+		const float loop_natural_frequency_hz = 30.0f,
+		const float max_carrier_offset_hz = 1500.0f
+	);
+
+	// Frequency of the tracked carrier relative to the channel center.
+	float carrier_offset_hz() const;
+	bool locked() const;
+
+private:
+	static constexpr float k = 1.0f / 32768.0f;
+	static constexpr float acquire_bandwidth_factor = 5.0f;
+	static constexpr int32_t lock_count_max = 8;
+
+	struct LoopGains {
+		int32_t kp;
+		int32_t ki;
+	};
+
+	uint32_t phase_ { 0 };
+	int32_t frequency_ { 0 };
+	int32_t frequency_max_ { 0 };
+	LoopGains track_ { 0, 0 };
+	LoopGains acquire_ { 0, 0 };
+	int32_t error_scale_ { 0 };
+	int32_t lock_count_ { 0 };
+	float sampling_rate_ { 0 };
+
+	static LoopGains loop_gains(const float sampling_rate, const float natural_frequency_hz);
+};
+
 class FM {
 public:
+	/* Discriminators, operating on t = s[n] * conj(s[n-1]). The float
+	 * output uses the float variant, the int16_t output the fixed-point
+	 * variant. See dsp_demodulate.cpp for error and cycle figures.
+	 */
+	enum class Discriminator {
+		Atan2,			// atan2f(), reference.
+		Polynomial,		// Octant-folded polynomial arctangent.
+		CrossProduct,	// Im(t) / |s[n]|^2, no arctangent.
+	};
+
 	buffer_f32_t execute(
 		const buffer_c16_t& src,
 		const buffer_f32_t& dst
@@ -61,12 +118,25 @@ public:
 		const buffer_s16_t& dst
 	);
 
-	void configure(const float sampling_rate, const float deviation_hz);
+	void configure(
+		const float sampling_rate,
+		const float deviation_hz,
+		const Discriminator discriminator = Discriminator::Polynomial
+	);
 
 private:
 	complex16_t::rep_type z_ { 0 };
 	float kf { 0 };
 	float ks16 { 0 };
+	int64_t ks16_fxpt_atan2 { 0 };
+	int64_t ks16_q15 { 0 };
+	Discriminator discriminator_ { Discriminator::Polynomial };
+
+	template<typename Discriminate>
+	buffer_f32_t execute_f32(const buffer_c16_t& src, const buffer_f32_t& dst, Discriminate discriminate);
+
+	template<typename Discriminate>
+	buffer_s16_t execute_s16(const buffer_c16_t& src, const buffer_s16_t& dst, Discriminate discriminate);
 };
 
 } /* namespace demodulate */
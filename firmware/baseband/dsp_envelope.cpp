@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_envelope.hpp"
+
+#include <hal.h>
+
+namespace dsp {
+namespace envelope {
+
+/* Per-halfword |x|. The subtract sets GE where -x >= 0, SEL picks -x there. */
+static inline uint32_t abs16(const uint32_t x) {
+	const uint32_t neg = __SSUB16(0, x);
+	return __SEL(neg, x);
+}
+
+/* Per-halfword max(a, b) + 3/8 * min(a, b), a and b non-negative. */
+static inline uint32_t alpha_max_beta_min(const uint32_t a, const uint32_t b) {
+	__SSUB16(a, b);							// GE where a >= b
+	const uint32_t max = __SEL(a, b);
+	const uint32_t min = __SEL(b, a);
+	const uint32_t min_2 = __SHADD16(min, 0);
+	const uint32_t min_4 = __SHADD16(min_2, 0);
+	const uint32_t min_3_8 = __SHADD16(min_2, min_4);
+	return __SADD16(max, min_3_8);
+}
+
+void MagnitudeC8::set_offset(const int16_t offset_i, const int16_t offset_q) {
+	offset_i_i = __PKHBT(static_cast<uint16_t>(offset_i), offset_i, 16);
+	offset_q_q = __PKHBT(static_cast<uint16_t>(offset_q), offset_q, 16);
+}
+
+buffer_u16_t MagnitudeC8::execute(
+	const buffer_c8_t& src,
+	const buffer_u16_t& dst
+) {
+	auto src_p = src.p;
+	const auto src_end = &src.p[src.count];
+	auto dst_p = dst.p;
+	while(src_p < src_end) {
+		const uint32_t q1_i1_q0_i0 = *__SIMD32(src_p)++;
+		const uint32_t q3_i3_q2_i2 = *__SIMD32(src_p)++;
+
+		const uint32_t i1_i0 = abs16(__SSUB16(__SXTB16(q1_i1_q0_i0, 0), offset_i_i));
+		const uint32_t q1_q0 = abs16(__SSUB16(__SXTB16(q1_i1_q0_i0, 8), offset_q_q));
+		const uint32_t i3_i2 = abs16(__SSUB16(__SXTB16(q3_i3_q2_i2, 0), offset_i_i));
+		const uint32_t q3_q2 = abs16(__SSUB16(__SXTB16(q3_i3_q2_i2, 8), offset_q_q));
+
+		*__SIMD32(dst_p)++ = alpha_max_beta_min(i1_i0, q1_q0);
+		*__SIMD32(dst_p)++ = alpha_max_beta_min(i3_i2, q3_q2);
+	}
+
+	return { dst.p, src.count, src.sampling_rate };
+}
+
+} /* namespace envelope */
+} /* namespace dsp */
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_ENVELOPE_H__
+#define __DSP_ENVELOPE_H__
+
+#include "dsp_types.hpp"
+#include "complex.hpp"
+
+#include <cstdint>
+
+#include <hal.h>
+
+namespace dsp {
+namespace envelope {
+
+/* Magnitude of complex8 samples, DC offset removed first. Alpha max plus
+ * beta min with alpha = 1, beta = 3/8: within 7% of the true magnitude,
+ * with no multiplies. Four samples per iteration, count must be a
+ * multiple of four.
+ */
+class MagnitudeC8 {
+public:
+	void set_offset(const int16_t offset_i, const int16_t offset_q);
+
+	buffer_u16_t execute(
+		const buffer_c8_t& src,
+		const buffer_u16_t& dst
+	);
+
+private:
+	/* Offsets, packed into both halfwords */
+	uint32_t offset_i_i { 0 };
+	uint32_t offset_q_q { 0 };
+};
+
+/* Magnitude squared of a complex16 sample, one SMUAD. Per sample so that
+ * decimating callers only pay for the samples they keep.
+ */
+class MagSquaredC16 {
+public:
+	uint32_t execute_once(const complex16_t sample) const {
+		const uint32_t q_i = sample.__rep();
+		return __SMUAD(q_i, q_i);
+	}
+};
+
+} /* namespace envelope */
+} /* namespace dsp */
+
+#endif/*__DSP_ENVELOPE_H__*/
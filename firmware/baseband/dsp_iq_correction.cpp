@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_iq_correction.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dsp {
+namespace iq_correction {
+
+void IQCorrection::update(const buffer_c8_t& src) {
+	if( src.count < samples_per_buffer ) {
+		return;
+	}
+
+	const uint32_t* src_p = reinterpret_cast<const uint32_t*>(src.p);
+	for(size_t n=0; n<samples_per_buffer / 2; n++) {
+		const uint32_t q1_i1_q0_i0 = *(src_p++);
+		const uint32_t i1_i0 = __SXTB16(q1_i1_q0_i0, 0);
+		const uint32_t q1_q0 = __SXTB16(q1_i1_q0_i0, 8);
+		sum_i = __SMLAD(i1_i0, 0x00010001, sum_i);
+		sum_q = __SMLAD(q1_q0, 0x00010001, sum_q);
+		sum_ii = __SMLAD(i1_i0, i1_i0, sum_ii);
+		sum_qq = __SMLAD(q1_q0, q1_q0, sum_qq);
+		sum_iq = __SMLAD(i1_i0, q1_q0, sum_iq);
+	}
+
+	buffer_count++;
+	if( buffer_count == buffers_per_update ) {
+		update_estimates();
+
+		sum_i = 0;
+		sum_q = 0;
+		sum_ii = 0;
+		sum_qq = 0;
+		sum_iq = 0;
+		buffer_count = 0;
+	}
+}
+
+void IQCorrection::update_estimates() {
+	constexpr float k = 1.0f / (samples_per_buffer * buffers_per_update);
+
+	const float mean_i = sum_i * k;
+	const float mean_q = sum_q * k;
+	const float var_i = sum_ii * k - mean_i * mean_i;
+	const float var_q = sum_qq * k - mean_q * mean_q;
+	const float cov_iq = sum_iq * k - mean_i * mean_q;
+
+	dc_i_ += (mean_i - dc_i_) * smoothing;
+	dc_q_ += (mean_q - dc_q_) * smoothing;
+
+	// Imbalance needs something more than quantization noise to measure.
+	if( var_i > 1.0f ) {
+		// Decorrelate Q from I, then match Q power to I power.
+		const float phase = -cov_iq / var_i;
+		const float var_q_corrected = var_q - cov_iq * cov_iq / var_i;
+		if( var_q_corrected > 0.0f ) {
+			const float gain = std::sqrt(var_i / var_q_corrected);
+			phase_ += (std::max(-0.25f, std::min(phase, 0.25f)) - phase_) * smoothing;
+			gain_ += (std::max(0.75f, std::min(gain, 1.33f)) - gain_) * smoothing;
+		}
+	}
+
+	const int32_t dc_i_whole = std::lround(dc_i_);
+	const int32_t k_q = std::lround(4096.0f * gain_);
+	const int32_t k_i = std::lround(4096.0f * gain_ * phase_);
+	const int32_t c = std::lround(-4096.0f * gain_ * (dc_q_ + phase_ * dc_i_)) + 2048;
+
+	coefficients_.dc_i_i = __PKHBT(dc_i_whole, dc_i_whole, 16);
+	coefficients_.k_q_i = __PKHBT(k_i, k_q, 16);
+	coefficients_.c = c;
+}
+
+} /* namespace iq_correction */
+} /* namespace dsp */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_IQ_CORRECTION_H__
+#define __DSP_IQ_CORRECTION_H__
+
+#include "dsp_types.hpp"
+
+#include <cstdint>
+#include <cstddef>
+
+#include <hal.h>
+
+namespace dsp {
+namespace iq_correction {
+
+/* Removes DC offset and IQ gain/phase imbalance from complex8 samples as a
+ * first decimation stage unpacks them to halfwords, two samples at a time:
+ *
+ *   i' = i - dc_i
+ *   q' = (k_q * q + k_i * i + c) >> 12
+ *
+ * dc_i is whole LSBs, the Q path (with c) carries fractional DC.
+ */
+struct Coefficients {
+	uint32_t dc_i_i { 0 };						// DC offset of I, in both halfwords
+	uint32_t k_q_i { (4096U << 16) | 0 };		// k_q:k_i
+	int32_t c { 2048 };							// Q DC correction and rounding
+
+	void apply(uint32_t& i1_i0, uint32_t& q1_q0) const {
+		const uint32_t q0_i0 = __PKHBT(i1_i0, q1_q0, 16);
+		const uint32_t q1_i1 = __PKHTB(q1_q0, i1_i0, 16);
+		const int32_t q0 = __SMLAD(q0_i0, k_q_i, c);
+		const int32_t q1 = __SMLAD(q1_i1, k_q_i, c);
+		i1_i0 = __SSUB16(i1_i0, dc_i_i);
+		q1_q0 = __PKHBT(q0 >> 12, q1, 4);
+	}
+};
+
+/* Blind estimator: sums, powers and I*Q cross products of the first few
+ * samples of every buffer are accumulated over many buffers, then folded
+ * (slowly) into the DC and imbalance estimates. Costs a few percent of a
+ * pass over the data.
+ */
+class IQCorrection {
+public:
+	void update(const buffer_c8_t& src);
+
+	Coefficients coefficients() const {
+		return coefficients_;
+	}
+
+	float dc_i() const { return dc_i_; }
+	float dc_q() const { return dc_q_; }
+
+private:
+	static constexpr size_t samples_per_buffer = 32;
+	static constexpr size_t buffers_per_update = 64;
+	static constexpr float smoothing = 0.25f;
+
+	int32_t sum_i { 0 };
+	int32_t sum_q { 0 };
+	int32_t sum_ii { 0 };
+	int32_t sum_qq { 0 };
+	int32_t sum_iq { 0 };
+	size_t buffer_count { 0 };
+
+	float dc_i_ { 0.0f };
+	float dc_q_ { 0.0f };
+	float phase_ { 0.0f };
+	float gain_ { 1.0f };
+
+	Coefficients coefficients_ { };
+
+	void update_estimates();
+};
+
+} /* namespace iq_correction */
+} /* namespace dsp */
+
+#endif/*__DSP_IQ_CORRECTION_H__*/
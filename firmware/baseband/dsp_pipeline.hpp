@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_PIPELINE_H__
+#define __DSP_PIPELINE_H__
+
+#include "dsp_types.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace dsp {
+namespace pipeline {
+
+namespace detail {
+
+template<typename Stage>
+using output_of = decltype(std::declval<Stage&>().execute(
+	std::declval<const buffer_t<typename Stage::sample_t>&>(),
+	std::declval<const buffer_c16_t&>()
+));
+
+template<typename... Stages>
+constexpr size_t decimation_factor(const size_t stage_count) {
+	constexpr size_t factors[] { Stages::decimation_factor..., 1 };
+	size_t result = 1;
+	for(size_t i=0; i<stage_count; i++) {
+		result *= factors[i];
+	}
+	return result;
+}
+
+template<typename... Stages>
+constexpr bool divides_evenly(size_t value) {
+	constexpr size_t factors[] { Stages::decimation_factor..., 1 };
+	for(size_t i=0; i<sizeof...(Stages); i++) {
+		if( (factors[i] == 0) || (value % factors[i]) ) {
+			return false;
+		}
+		value /= factors[i];
+	}
+	return true;
+}
+
+template<typename... Stages>
+constexpr bool runs_in_place() {
+	/* Output sample n is written after input samples up to n * decimation
+	 * factor have been read, so a stage may share its source buffer if it
+	 * writes no more bytes than it consumes.
+	 */
+	constexpr size_t consumed[] { sizeof(typename Stages::sample_t) * Stages::decimation_factor..., 0 };
+	for(size_t i=0; i<sizeof...(Stages); i++) {
+		if( consumed[i] < sizeof(complex16_t) ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template<typename... Stages>
+constexpr bool outputs_complex16() {
+	constexpr bool same[] { std::is_same<output_of<Stages>, buffer_c16_t>::value..., true };
+	for(size_t i=0; i<sizeof...(Stages); i++) {
+		if( !same[i] ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template<typename First, typename... Rest>
+constexpr bool chains() {
+	constexpr bool same[] { std::is_same<typename Rest::sample_t, complex16_t>::value..., true };
+	for(size_t i=0; i<sizeof...(Rest); i++) {
+		if( !same[i] ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} /* namespace detail */
+
+/* Fixed-rate decimation stages run back to back, each in place in one
+ * shared scratch buffer that is sized for the first stage's output.
+ * Block sizes, sample rates and buffer reuse are checked at compile time.
+ *
+ * A stage provides sample_t (input sample type), a constexpr
+ * decimation_factor and buffer_c16_t execute(src, dst).
+ */
+template<size_t InputSamplingRate, size_t InputCount, typename... Stages>
+class Pipeline {
+public:
+	static_assert(sizeof...(Stages) > 0, "Pipeline needs at least one stage");
+	static_assert(detail::divides_evenly<Stages...>(InputCount), "Block size does not divide evenly through every stage");
+	static_assert(detail::divides_evenly<Stages...>(InputSamplingRate), "Sample rate does not divide evenly through every stage");
+	static_assert(detail::outputs_complex16<Stages...>(), "Stages must produce complex16 samples");
+	static_assert(detail::chains<Stages...>(), "Stages after the first must take complex16 samples");
+	static_assert(detail::runs_in_place<Stages...>(), "Stage writes faster than it reads, cannot run in place");
+
+	template<size_t N>
+	using stage_t = typename std::tuple_element<N, std::tuple<Stages...>>::type;
+
+	static constexpr size_t stage_count = sizeof...(Stages);
+	static constexpr size_t decimation_factor = detail::decimation_factor<Stages...>(stage_count);
+	static constexpr size_t output_sampling_rate = InputSamplingRate / decimation_factor;
+	static constexpr size_t output_count = InputCount / decimation_factor;
+	static constexpr size_t scratch_count = InputCount / stage_t<0>::decimation_factor;
+
+	/* Input sampling rate of stage N, or the output rate for N == stage_count. */
+	template<size_t N>
+	static constexpr size_t sampling_rate() {
+		static_assert(N <= stage_count, "No such stage");
+		return InputSamplingRate / detail::decimation_factor<Stages...>(N);
+	}
+
+	template<size_t N>
+	stage_t<N>& stage() {
+		return std::get<N>(stages);
+	}
+
+	buffer_c16_t execute(const buffer_t<typename stage_t<0>::sample_t>& src) {
+		return execute_stage(src, stage_index<0> { });
+	}
+
+	/* Scratch memory, free for later processing once execute() returns. */
+	template<typename T>
+	buffer_t<T> scratch() {
+		static_assert(alignof(T) <= alignof(complex16_t), "Scratch buffer is not aligned for this type");
+		return {
+			reinterpret_cast<T*>(scratch_.data()),
+			sizeof(scratch_) / sizeof(T)
+		};
+	}
+
+private:
+	template<size_t N>
+	using stage_index = std::integral_constant<size_t, N>;
+
+	std::tuple<Stages...> stages { };
+	std::array<complex16_t, scratch_count> scratch_ { };
+	const buffer_c16_t scratch_buffer {
+		scratch_.data(),
+		scratch_.size()
+	};
+
+	template<typename Buffer, size_t N>
+	buffer_c16_t execute_stage(const Buffer& src, stage_index<N>) {
+		const auto out = std::get<N>(stages).execute(src, scratch_buffer);
+		return execute_stage(out, stage_index<N + 1> { });
+	}
+
+	buffer_c16_t execute_stage(const buffer_c16_t& src, stage_index<stage_count>) {
+		return src;
+	}
+};
+
+} /* namespace pipeline */
+} /* namespace dsp */
+
+#endif/*__DSP_PIPELINE_H__*/
@@ -21,33 +21,92 @@
 
 #include "dsp_squelch.hpp"
 
+#include "hal.h"
+
 #include <cstdint>
 #include <array>
+#include <algorithm>
 
-bool FMSquelch::execute(const buffer_f32_t& audio) {
-	if( threshold_squared == 0.0f ) {
+bool NoiseSquelch::execute(const buffer_f32_t& audio) {
+	if( threshold_open == 0 ) {
 		return true;
 	}
 
-	// TODO: No hard-coded array size.
-	std::array<float, N> squelch_energy_buffer;
-	const buffer_f32_t squelch_energy {
-		squelch_energy_buffer.data(),
-		squelch_energy_buffer.size()
-	};
-	non_audio_hpf.execute(audio, squelch_energy);
+	std::array<int16_t, N> chunk_buffer;
+	for(size_t offset=0; offset<audio.count; offset+=N) {
+		const size_t count = std::min(N, audio.count - offset);
+		for(size_t i=0; i<count; i++) {
+			const int32_t sample_int = audio.p[offset + i] * 32768.0f;
+			chunk_buffer[i] = __SSAT(sample_int, 16);
+		}
+		update({ chunk_buffer.data(), count, audio.sampling_rate });
+	}
+
+	return open;
+}
 
-	float non_audio_max_squared = 0;
-	for(const auto sample : squelch_energy_buffer) {
-		const float sample_squared = sample * sample;
-		if( sample_squared > non_audio_max_squared ) {
-			non_audio_max_squared = sample_squared;
+bool NoiseSquelch::execute(const buffer_s16_t& audio) {
+	if( threshold_open == 0 ) {
+		return true;
+	}
+
+	std::array<int16_t, N> chunk_buffer;
+	for(size_t offset=0; offset<audio.count; offset+=N) {
+		const size_t count = std::min(N, audio.count - offset);
+		std::copy(&audio.p[offset], &audio.p[offset + count], chunk_buffer.begin());
+		update({ chunk_buffer.data(), count, audio.sampling_rate });
+	}
+
+	return open;
+}
+
+void NoiseSquelch::update(const buffer_s16_t& chunk) {
+	if( chunk.sampling_rate != sampling_rate ) {
+		sampling_rate = chunk.sampling_rate;
+		attack_samples = sampling_rate * attack_ms / 1000;
+		release_samples = sampling_rate * release_ms / 1000;
+
+		uint32_t cutoff = noise_cutoff_hz;
+		if( cutoff > (sampling_rate * 3 / 8) ) {
+			cutoff = sampling_rate * 3 / 8;
 		}
+		non_audio_hpf[0].configure(iir_biquad_highpass(cutoff, sampling_rate, 0.54119610f));
+		non_audio_hpf[1].configure(iir_biquad_highpass(cutoff, sampling_rate, 1.30656296f));
+	}
+
+	for(auto& section : non_audio_hpf) {
+		section.execute_in_place(chunk);
+	}
+
+	uint32_t energy_sum = 0;
+	for(size_t i=0; i<chunk.count; i++) {
+		const int32_t sample = chunk.p[i];
+		energy_sum += static_cast<uint32_t>(sample * sample) >> energy_shift;
 	}
 
-	return (non_audio_max_squared < threshold_squared);
+	// Mean square, smoothed over a few chunks.
+	const int32_t energy = energy_sum / chunk.count;
+	noise_energy += (energy - noise_energy) / 4;
+
+	const bool toggle = open ? (noise_energy > threshold_close) : (noise_energy < threshold_open);
+	if( toggle ) {
+		pending_samples += chunk.count;
+		if( pending_samples >= (open ? release_samples : attack_samples) ) {
+			open = !open;
+			pending_samples = 0;
+		}
+	} else {
+		pending_samples = 0;
+	}
 }
 
-void FMSquelch::set_threshold(const float new_value) {
-	threshold_squared = new_value * new_value;
+void NoiseSquelch::set_threshold(const float new_value) {
+	// Full scale is 1.0 in the float path and 32768 in the int16_t path.
+	const float threshold_s16 = std::min(new_value, 1.0f) * 32768.0f;
+	threshold_open = static_cast<uint32_t>(threshold_s16 * threshold_s16) >> energy_shift;
+	threshold_close = threshold_open * 2;
+	pending_samples = 0;
+	if( threshold_open == 0 ) {
+		open = true;
+	}
 }
@@ -24,22 +24,51 @@
 
 #include "buffer.hpp"
 #include "dsp_iir.hpp"
-#include "dsp_iir_config.hpp"
 
 #include <cstdint>
 #include <cstddef>
+#include <array>
 
-class FMSquelch {
+/* Noise squelch for demodulated audio. Measures the energy above the voice
+ * band, fixed-point, and opens when it stays below the threshold for
+ * attack_ms. It closes when it stays above twice the threshold energy (3dB
+ * of hysteresis) for release_ms. The noise high-pass is a fourth-order
+ * Butterworth at noise_cutoff_hz, lowered to 3/8 of the sampling rate where
+ * Nyquist would not leave room above it (4.5kHz for 12kHz AM audio).
+ */
+class NoiseSquelch {
 public:
+	/* Returns true while the squelch is open. */
 	bool execute(const buffer_f32_t& audio);
+	bool execute(const buffer_s16_t& audio);
 
+	/* RMS noise threshold, full scale is 1.0. Zero keeps the squelch open. */
 	void set_threshold(const float new_value);
 
+	bool is_open() const {
+		return open;
+	}
+
 private:
 	static constexpr size_t N = 32;
-	float threshold_squared { 0.0f };
+	static constexpr uint32_t attack_ms = 10;
+	static constexpr uint32_t release_ms = 150;
+	static constexpr uint32_t noise_cutoff_hz = 8000;
+	/* Squares are pre-shifted so a block of N full scale samples fits. */
+	static constexpr size_t energy_shift = 6;
+
+	int32_t threshold_open { 0 };
+	int32_t threshold_close { 0 };
+	int32_t noise_energy { 0 };
+	uint32_t pending_samples { 0 };
+	uint32_t sampling_rate { 0 };
+	uint32_t attack_samples { 0 };
+	uint32_t release_samples { 0 };
+	bool open { true };
+
+	std::array<IIRBiquadFilterS16, 2> non_audio_hpf { };
 
-	IIRBiquadFilter non_audio_hpf { non_audio_hpf_config };
+	void update(const buffer_s16_t& chunk);
 };
 
 #endif/*__DSP_SQUELCH_H__*/
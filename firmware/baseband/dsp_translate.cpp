@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_translate.hpp"
+
+#include "sine_table.hpp"
+
+#include <hal.h>
+
+namespace dsp {
+namespace translate {
+
+namespace {
+
+constexpr sine_table_rotation_q15_t rotation_table = make_sine_table_rotation_q15();
+
+} /* namespace */
+
+void TranslateC16::configure(
+	const int32_t shift_frequency,
+	const uint32_t sampling_rate
+) {
+	phase = 0;
+	phase_inc = static_cast<uint32_t>((static_cast<int64_t>(shift_frequency) << 32) / sampling_rate);
+}
+
+buffer_c16_t TranslateC16::execute(
+	const buffer_c16_t& src,
+	const buffer_c16_t& dst
+) {
+	const uint32_t* const s = reinterpret_cast<const uint32_t*>(src.p);
+	uint32_t* const d = reinterpret_cast<uint32_t*>(dst.p);
+
+	/* Round to the nearest table entry rather than truncating. */
+	constexpr uint32_t phase_round = 1U << (31 - sine_table_f32_period_log2);
+
+	auto p = phase;
+	for(size_t i=0; i<src.count; i++) {
+		const uint32_t q_i = s[i];
+		const uint32_t sin_cos = rotation_table.w[(p + phase_round) >> (32 - sine_table_f32_period_log2)];
+		p += phase_inc;
+
+		// real = i * cos - q * sin, imag = i * sin + q * cos
+		const int32_t real = __SMUSD(q_i, sin_cos) >> 15;
+		const int32_t imag = __SMUADX(q_i, sin_cos) >> 15;
+		d[i] = __PKHBT(__SSAT(real, 16), __SSAT(imag, 16), 16);
+	}
+	phase = p;
+
+	return {
+		dst.p,
+		src.count,
+		src.sampling_rate,
+		src.timestamp
+	};
+}
+
+} /* namespace translate */
+} /* namespace dsp */
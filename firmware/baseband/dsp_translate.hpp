@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_TRANSLATE_H__
+#define __DSP_TRANSLATE_H__
+
+#include <cstdint>
+
+#include "dsp_types.hpp"
+
+namespace dsp {
+namespace translate {
+
+/* Shifts a complex16 stream by an arbitrary frequency. The local oscillator
+ * is a 32-bit phase accumulator indexing a 256-entry Q15 cos/sin table, so
+ * phase error is at most pi/256 (spurs around -38dBc).
+ */
+class TranslateC16 {
+public:
+	void configure(
+		const int32_t shift_frequency,
+		const uint32_t sampling_rate
+	);
+
+	/* src and dst may be the same buffer. */
+	buffer_c16_t execute(
+		const buffer_c16_t& src,
+		const buffer_c16_t& dst
+	);
+
+private:
+	uint32_t phase { 0 };
+	uint32_t phase_inc { 0 };
+};
+
+} /* namespace translate */
+} /* namespace dsp */
+
+#endif/*__DSP_TRANSLATE_H__*/
@@ -25,6 +25,8 @@
 
 #include "message_queue.hpp"
 
+#include "audio_dma.hpp"
+
 #include "ch.h"
 
 #include "lpc43xx_cpp.hpp"
@@ -101,6 +103,11 @@ void EventDispatcher::on_message(const Message* const message) {
 		on_message_shutdown(*reinterpret_cast<const ShutdownMessage*>(message));
 		break;
 
+	case Message::ID::AudioConfig:
+		on_message_audio_config(*reinterpret_cast<const AudioConfigMessage*>(message));
+		shared_memory.baseband_message = nullptr;
+		break;
+
 	default:
 		on_message_default(message);
 		shared_memory.baseband_message = nullptr;
@@ -112,6 +119,10 @@ void EventDispatcher::on_message_shutdown(const ShutdownMessage&) {
 	request_stop();
 }
 
+void EventDispatcher::on_message_audio_config(const AudioConfigMessage& message) {
+	audio::dma::set_buffering(message.block_samples, message.ring_depth);
+}
+
 void EventDispatcher::on_message_default(const Message* const message) {
 	baseband_processor->on_message(message);
 }
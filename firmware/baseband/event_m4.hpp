@@ -64,6 +64,7 @@ private:
 
 	void on_message(const Message* const message);
 	void on_message_shutdown(const ShutdownMessage&);
+	void on_message_audio_config(const AudioConfigMessage& message);
 	void on_message_default(const Message* const message);
 
 	void handle_spectrum();
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __FARROW_RESAMPLER_H__
+#define __FARROW_RESAMPLER_H__
+
+#include "dsp_types.hpp"
+#include "complex.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <complex>
+
+namespace dsp {
+namespace interpolation {
+
+/* Farrow structure: per tap, a cubic in the fractional position mu fitted
+ * (least squares, over each unit segment) to an 8-tap Kaiser-windowed sinc,
+ * cutoff 0.42fs, beta 6. Rows are powers of mu, columns are taps from newest
+ * to oldest sample. Rows are normalized to DC gain 1 (mu^0) and 0 (others).
+ *
+ * Resampling a tone 24kHz -> 48kHz, everything but the tone is below -60dB
+ * up to 0.21fs and -45dB at 0.33fs; a cubic Lagrange interpolator manages
+ * -44dB at 0.125fs and -27dB at 0.21fs.
+ */
+constexpr size_t farrow_taps_count = 8;
+constexpr size_t farrow_order = 3;
+
+constexpr std::array<std::array<float, farrow_taps_count>, farrow_order + 1> farrow_coefficients { {
+	{ { -0.00079256f, +0.01561703f, -0.06280690f, +0.12797902f, +0.83729061f, +0.13212105f, -0.06707414f, +0.01766590f } },
+	{ { -0.01120150f, +0.06240233f, -0.23185458f, +0.79914231f, +0.06037698f, -0.86745275f, +0.23414656f, -0.04555935f } },
+	{ { +0.03221904f, -0.13873159f, +0.18104026f, +0.59002713f, -1.44954641f, +0.91826707f, -0.15781731f, +0.02454181f } },
+	{ { -0.00255908f, -0.00636191f, +0.24574227f, -0.67985785f, +0.67985785f, -0.24574227f, +0.00636191f, +0.00255908f } },
+} };
+
+/* Arbitrary-ratio resampler, polyphase filter in Farrow form: the filter for
+ * any fractional position is evaluated from the polynomial coefficients above
+ * rather than stored per phase.
+ *
+ * Each input sample costs 32 MACs (one dot product per polynomial order),
+ * each output sample a 3-step Horner evaluation. Delay is four input samples.
+ *
+ * Like any interpolator it does not band-limit below its own cutoff: when
+ * decimating, filter the input to below the output Nyquist first (channel
+ * filters usually already have).
+ *
+ * T is the arithmetic type, float or std::complex<float>. Block execute()
+ * converts from and to the buffer's sample type.
+ */
+template<typename T>
+class FarrowResampler {
+public:
+	void configure(
+		const float input_rate,
+		const float output_rate
+	) {
+		phase_increment = calculate_increment(input_rate, output_rate);
+	}
+
+	void reset() {
+		x = { };
+		phase = 0.0f;
+	}
+
+	template<typename InterpolatedSampleHandler>
+	void operator()(
+		const T sample,
+		InterpolatedSampleHandler interpolated_sample_handler
+	) {
+		for(size_t k=farrow_taps_count-1; k>0; k--) {
+			x[k] = x[k - 1];
+		}
+		x[0] = sample;
+
+		std::array<T, farrow_order + 1> v;
+		for(size_t m=0; m<v.size(); m++) {
+			T acc { };
+			for(size_t k=0; k<farrow_taps_count; k++) {
+				acc += x[k] * farrow_coefficients[m][k];
+			}
+			v[m] = acc;
+		}
+
+		// Interpolating between x[4] (mu=0) and x[3] (mu=1).
+		while( phase < 1.0f ) {
+			const float mu = phase;
+			interpolated_sample_handler(((v[3] * mu + v[2]) * mu + v[1]) * mu + v[0]);
+			phase += phase_increment;
+		}
+		phase -= 1.0f;
+	}
+
+	void advance(const float fraction) {
+		phase += (fraction * phase_increment);
+	}
+
+	/* Resamples src into dst, returning the part of dst that was written.
+	 * dst must hold at least src.count / phase_increment + 1 samples; output
+	 * that doesn't fit is dropped.
+	 */
+	template<typename U>
+	buffer_t<U> execute(
+		const buffer_t<U>& src,
+		const buffer_t<U>& dst
+	) {
+		size_t n = 0;
+		for(size_t i=0; i<src.count; i++) {
+			(*this)(to_arithmetic(src.p[i]),
+				[&dst, &n](const T interpolated_sample) {
+					if( n < dst.count ) {
+						from_arithmetic(interpolated_sample, dst.p[n++]);
+					}
+				}
+			);
+		}
+		return {
+			dst.p,
+			n,
+			static_cast<uint32_t>(src.sampling_rate / phase_increment),
+			src.timestamp
+		};
+	}
+
+private:
+	std::array<T, farrow_taps_count> x { };
+	float phase { 0.0f };
+	float phase_increment { 1.0f };
+
+	static constexpr float calculate_increment(const float input_rate, const float output_rate) {
+		return input_rate / output_rate;
+	}
+
+	static int16_t saturate_s16(const float v) {
+		if( v >= 32767.0f ) {
+			return 32767;
+		}
+		if( v <= -32768.0f ) {
+			return -32768;
+		}
+		return static_cast<int16_t>((v < 0.0f) ? (v - 0.5f) : (v + 0.5f));
+	}
+
+	static float to_arithmetic(const float v) { return v; }
+	static float to_arithmetic(const int16_t v) { return v; }
+	static std::complex<float> to_arithmetic(const complex16_t v) { return v; }
+
+	static void from_arithmetic(const float v, float& out) { out = v; }
+	static void from_arithmetic(const float v, int16_t& out) { out = saturate_s16(v); }
+	static void from_arithmetic(const std::complex<float> v, complex16_t& out) {
+		out = { saturate_s16(v.real()), saturate_s16(v.imag()) };
+	}
+};
+
+} /* namespace interpolation */
+} /* namespace dsp */
+
+#endif/*__FARROW_RESAMPLER_H__*/
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "fm_stereo.hpp"
+
+#include "sine_table.hpp"
+
+#include <hal.h>
+
+#include <cmath>
+#include <algorithm>
+
+namespace dsp {
+namespace demodulate {
+
+namespace {
+
+constexpr float phase_per_radian { 4294967296.0f / (2.0f * pi) };
+
+} /* namespace */
+
+void FMStereo::configure(const uint32_t sampling_rate, const float difference_gain) {
+	constexpr uint32_t pilot_frequency { 19000 };
+	constexpr float damping { 0.707f };
+	constexpr float natural_frequency { 2.0f * pi * 5.0f };
+	constexpr float pull_in_hz { 20.0f };
+
+	const float fs = sampling_rate;
+	pilot_phase = 0;
+	pilot_phase_inc = (static_cast<uint64_t>(pilot_frequency) << 32) / sampling_rate;
+	pilot_frequency_offset = 0;
+	pilot_frequency_offset_max = pull_in_hz / fs * 4294967296.0f;
+
+	// Phase detector gain is 1.0/radian once normalized by the pilot level.
+	kp = 2.0f * damping * natural_frequency / fs * phase_per_radian;
+	ki = natural_frequency * natural_frequency / (fs * fs) * phase_per_radian;
+
+	pilot_i = 0;
+	pilot_q = 0;
+	lock_count = 0;
+	pilot_locked = false;
+
+	difference_gain_ = 2.0f * difference_gain;
+
+	rds_i_integrator = { };
+	rds_q_integrator = { };
+	rds_i_comb = { };
+	rds_q_comb = { };
+	rds_phase = 0;
+	rds_count_ = 0;
+}
+
+void FMStereo::execute(
+	const buffer_s16_t& mpx,
+	const buffer_s16_t& difference,
+	const buffer_c32_t& rds
+) {
+	constexpr float k { 1.0f / 32768.0f };
+	constexpr float level_alpha { 1.0f / 1024.0f };
+
+	rds_count_ = 0;
+
+	for(size_t n=0; n<mpx.count; n++) {
+		const float x = mpx.p[n] * k;
+		const float s1 = sin_f32_phase(pilot_phase);
+		const float c1 = sin_f32_phase(pilot_phase + 0x40000000U);
+
+		/* Pilot is A*sin(theta): x*sin(phase) averages to A/2, x*cos(phase) to
+		 * (A/2)*sin(theta - phase). Averaging first keeps program audio out of
+		 * the phase detector, which would otherwise bias it.
+		 */
+		pilot_i += (x * s1 - pilot_i) * level_alpha;
+		pilot_q += (x * c1 - pilot_q) * level_alpha;
+		const float error = std::min(std::max(pilot_q / std::max(pilot_i, pilot_level_min * 0.5f), -1.0f), 1.0f);
+
+		pilot_frequency_offset = std::min(std::max(pilot_frequency_offset + ki * error, -pilot_frequency_offset_max), pilot_frequency_offset_max);
+		pilot_phase += pilot_phase_inc + static_cast<int32_t>(pilot_frequency_offset + kp * error);
+
+		// Harmonics of the pilot, subcarriers are in phase with it.
+		const float s2 = 2.0f * s1 * c1;
+		const float s3 = s1 * (3.0f - 4.0f * s1 * s1);
+		const float c3 = c1 * (4.0f * c1 * c1 - 3.0f);
+
+		const int32_t d = pilot_locked ? static_cast<int32_t>(x * s2 * difference_gain_ * 32768.0f) : 0;
+		difference.p[n] = __SSAT(d, 16);
+
+		/* CIC, 16-bit input grows by 12 bits. Unsigned so that the integrators
+		 * wrap as intended.
+		 */
+		uint32_t vi = static_cast<int32_t>(x * c3 * 32768.0f);
+		uint32_t vq = static_cast<int32_t>(-x * s3 * 32768.0f);
+		for(size_t i=0; i<rds_i_integrator.size(); i++) {
+			vi = rds_i_integrator[i] += vi;
+			vq = rds_q_integrator[i] += vq;
+		}
+
+		if( ++rds_phase >= rds_decimation ) {
+			rds_phase = 0;
+			for(size_t i=0; i<rds_i_comb.size(); i++) {
+				const uint32_t yi = vi - rds_i_comb[i];
+				const uint32_t yq = vq - rds_q_comb[i];
+				rds_i_comb[i] = vi;
+				rds_q_comb[i] = vq;
+				vi = yi;
+				vq = yq;
+			}
+			if( rds_count_ < rds.count ) {
+				rds.p[rds_count_++] = { static_cast<int32_t>(vi), static_cast<int32_t>(vq) };
+			}
+		}
+	}
+
+	update_lock();
+}
+
+/* Lock needs the pilot level and a small phase error to hold for ~170ms of
+ * 128-sample buffers at 192kHz; losing it takes as long.
+ */
+void FMStereo::update_lock() {
+	const bool good = (pilot_i >= pilot_level_min * 0.5f) && (std::abs(pilot_q) < pilot_i * 0.5f);
+	if( good ) {
+		if( lock_count < lock_count_max ) {
+			lock_count++;
+		} else {
+			pilot_locked = true;
+		}
+	} else {
+		if( lock_count > 0 ) {
+			lock_count--;
+		} else {
+			pilot_locked = false;
+		}
+	}
+}
+
+} /* namespace demodulate */
+} /* namespace dsp */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __FM_STEREO_H__
+#define __FM_STEREO_H__
+
+#include "dsp_types.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace dsp {
+namespace demodulate {
+
+/* Broadcast FM multiplex: a PLL locks to the 19kHz pilot, its second harmonic
+ * recovers L-R from the 38kHz DSB-SC subcarrier and its third harmonic mixes
+ * the 57kHz RDS subcarrier down to complex baseband.
+ */
+class FMStereo {
+public:
+	/* RDS baseband is integrated and dumped by this factor (CIC, 3rd order). */
+	static constexpr size_t rds_decimation { 16 };
+
+	void configure(const uint32_t sampling_rate, const float difference_gain);
+
+	/* mpx at sampling_rate, wide enough for 57kHz. Writes (L-R)/2 to
+	 * difference (zeros without a pilot), RDS baseband to rds.
+	 */
+	void execute(
+		const buffer_s16_t& mpx,
+		const buffer_s16_t& difference,
+		const buffer_c32_t& rds
+	);
+
+	bool stereo() const {
+		return pilot_locked;
+	}
+
+	/* RDS samples written by the last execute(). */
+	size_t rds_count() const {
+		return rds_count_;
+	}
+
+private:
+	static constexpr float pilot_level_min { 0.02f };
+	static constexpr size_t lock_count_max { 256 };
+
+	uint32_t pilot_phase { 0 };
+	uint32_t pilot_phase_inc { 0 };
+	float pilot_frequency_offset { 0 };
+	float pilot_frequency_offset_max { 0 };
+	float kp { 0 };
+	float ki { 0 };
+
+	float pilot_i { 0 };
+	float pilot_q { 0 };
+	size_t lock_count { 0 };
+	bool pilot_locked { false };
+
+	float difference_gain_ { 2.0f };
+
+	std::array<uint32_t, 3> rds_i_integrator { };
+	std::array<uint32_t, 3> rds_q_integrator { };
+	std::array<uint32_t, 3> rds_i_comb { };
+	std::array<uint32_t, 3> rds_q_comb { };
+	size_t rds_phase { 0 };
+	size_t rds_count_ { 0 };
+
+	void update_lock();
+};
+
+} /* namespace demodulate */
+} /* namespace dsp */
+
+#endif/*__FM_STEREO_H__*/
@@ -24,6 +24,8 @@
 #include <algorithm>
 #include <cmath>
 
+#include <hal.h>
+
 #include "utility.hpp"
 
 namespace dsp {
@@ -34,74 +36,77 @@ void MatchedFilter::configure(
 	const size_t taps_count,
 	const size_t decimation_factor
 ) {
-	samples_ = std::make_unique<samples_t>(taps_count);
+	samples_ = std::make_unique<samples_t>(taps_count * 2);
 	taps_reversed_ = std::make_unique<taps_t>(taps_count);
 	taps_count_ = taps_count;
+	write_index = 0;
 	decimation_factor_ = decimation_factor;
+	decimation_phase = 0;
 	output = 0;
-	std::reverse_copy(&taps[0], &taps[taps_count], &taps_reversed_[0]);
+
+	float tap_max = 0.0f;
+	for(size_t n=0; n<taps_count; n++) {
+		tap_max = std::max(tap_max, std::max(std::abs(taps[n].real()), std::abs(taps[n].imag())));
+	}
+	const float tap_scale = (tap_max > 0.0f) ? (32767.0f / tap_max) : 1.0f;
+	output_scale = 1.0f / tap_scale;
+
+	for(size_t n=0; n<taps_count; n++) {
+		const auto tap = taps[taps_count - 1 - n];
+		taps_reversed_[n] = {
+			static_cast<int16_t>(std::round(tap.real() * tap_scale)),
+			static_cast<int16_t>(std::round(tap.imag() * tap_scale))
+		};
+	}
 }
 
 bool MatchedFilter::execute_once(
 	const sample_t input
 ) {
-	samples_[taps_count_ - decimation_factor_ + decimation_phase] = input;
+	samples_[write_index] = input;
+	samples_[write_index + taps_count_] = input;
+	write_index++;
+	if( write_index == taps_count_ ) {
+		write_index = 0;
+	}
 
 	advance_decimation_phase();
 	if( is_new_decimation_cycle() ) {
-		float sr_tr = 0.0f;
-		float si_tr = 0.0f;
-		float si_ti = 0.0f;
-		float sr_ti = 0.0f;
+		// Oldest sample first, lined up with the last tap.
+		const auto* s = &samples_[write_index];
+		const auto* t = &taps_reversed_[0];
+
+		int64_t r_n = 0;
+		int64_t r_p = 0;
+		int64_t i_n = 0;
+		int64_t i_p = 0;
 		for(size_t n=0; n<taps_count_; n++) {
-			const auto sample = samples_[n];
-			const auto tap = taps_reversed_[n];
+			const uint32_t sample = (s++)->__rep();
+			const uint32_t tap = (t++)->__rep();
 
-			sr_tr += sample.real() * tap.real();
-			si_ti += sample.imag() * tap.imag();
-			si_tr += sample.imag() * tap.real();
-			sr_ti += sample.real() * tap.imag();
+			// N: complex multiple of samples and taps (conjugate, tap.i negated).
+			// P: complex multiply of samples and taps.
+			r_n = __SMLALD(sample, tap, r_n);		// sr * tr + si * ti
+			r_p = __SMLSLD(sample, tap, r_p);		// sr * tr - si * ti
+			i_n = __SMLSLDX(sample, tap, i_n);		// sr * ti - si * tr, i_n negated
+			i_p = __SMLALDX(sample, tap, i_p);		// sr * ti + si * tr
 		}
 
-		// N: complex multiple of samples and taps (conjugate, tap.i negated).
-		// P: complex multiply of samples and taps.
-		const auto r_n = sr_tr + si_ti;
-		const auto r_p = sr_tr - si_ti;
-		const auto i_n = si_tr - sr_ti;
-		const auto i_p = si_tr + sr_ti;
+		const float r_n_f = r_n;
+		const float r_p_f = r_p;
+		const float i_n_f = i_n;
+		const float i_p_f = i_p;
 
-		const auto mag_n = std::sqrt(r_n * r_n + i_n * i_n);
-		const auto mag_p = std::sqrt(r_p * r_p + i_p * i_p);
+		const auto mag_n = std::sqrt(r_n_f * r_n_f + i_n_f * i_n_f);
+		const auto mag_p = std::sqrt(r_p_f * r_p_f + i_p_f * i_p_f);
 		const auto diff = mag_p - mag_n;
-		output = diff;
+		output = diff * output_scale;
 
-		shift_by_decimation_factor();
 		return true;
 	} else {
 		return false;
 	}
 }
 
-void MatchedFilter::shift_by_decimation_factor() {
-	const sample_t* s = &samples_[decimation_factor_];
-	sample_t* t = &samples_[0];
-	
-	const size_t unroll_factor = 4;
-	size_t shift_count = (taps_count_ - decimation_factor_) / unroll_factor;	
-	while(shift_count > 0) {
-		*t++ = *s++;
-		*t++ = *s++;
-		*t++ = *s++;
-		*t++ = *s++;
-		shift_count--;
-	}
-
-	shift_count = (taps_count_ - decimation_factor_) % unroll_factor;
-	while(shift_count > 0) {
-		*t++ = *s++;
-		shift_count--;
-	}
-}
-
 } /* namespace matched_filter */
 } /* namespace dsp */
@@ -26,6 +26,8 @@
 #include <complex>
 #include <memory>
 
+#include "complex.hpp"
+
 namespace dsp {
 namespace matched_filter {
 
@@ -34,13 +36,15 @@ namespace matched_filter {
 // the input signal to 0Hz/DC. This also means that the taps length must be
 // a multiple of the complex sinusoid period.
 
+// Samples and taps are Q15, multiply-accumulated two halves at a time into
+// 64-bit accumulators. Taps are designed in float and scaled to full range
+// when configured; the output keeps the float filter's scale.
+
 class MatchedFilter {
 public:
-	using sample_t = std::complex<float>;
+	using sample_t = complex16_t;
 	using tap_t = std::complex<float>;
 
-	using taps_t = tap_t[];
-
 	template<class T>
 	MatchedFilter(
 		const T& taps,
@@ -65,16 +69,19 @@ public:
 
 private:
 	using samples_t = sample_t[];
+	using taps_t = complex16_t[];
 
+	// History is a ring written twice, taps_count_ apart, so the most
+	// recent taps_count_ samples are always contiguous and never shifted.
 	std::unique_ptr<samples_t> samples_ { };
 	std::unique_ptr<taps_t> taps_reversed_ { };
 	size_t taps_count_ { 0 };
+	size_t write_index { 0 };
 	size_t decimation_factor_ { 1 };
 	size_t decimation_phase { 0 };
+	float output_scale { 1.0f };
 	float output { 0 };
 
-	void shift_by_decimation_factor();
-
 	void advance_decimation_phase() {
 		decimation_phase = (decimation_phase + 1) % decimation_factor_;
 	}
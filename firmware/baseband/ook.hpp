@@ -47,8 +47,11 @@ public:
 	symbol_t operator()(const std::complex<int16_t> in) {
 		const uint32_t real2 = in.real() * in.real();
 		const uint32_t imag2 = in.imag() * in.imag();
-		const uint32_t mag2 = real2 + imag2;
+		return (*this)(real2 + imag2);
+	}
 
+	/* For magnitudes squared already computed by an envelope stage */
+	symbol_t operator()(const uint32_t mag2) {
 		const uint32_t mag2_attenuated = mag2 >> 3;	// Approximation of (-4.5dB)^2
 		mag2_threshold = (uint64_t(mag2_threshold) * uint64_t(mag2_threshold_leak_factor)) >> 32;
 		mag2_threshold = std::max(mag2_threshold, mag2_attenuated);
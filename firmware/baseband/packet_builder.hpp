@@ -25,7 +25,6 @@
 #include <cstdint>
 #include <cstddef>
 #include <bitset>
-#include <functional>
 
 #include "bit_pattern.hpp"
 #include "baseband_packet.hpp"
@@ -47,15 +46,11 @@ struct FixedLength {
 template<typename PreambleMatcher, typename UnstuffMatcher, typename EndMatcher>
 class PacketBuilder {
 public:
-	using PayloadHandlerFunc = std::function<void(const baseband::Packet& packet)>;
-
 	PacketBuilder(
 		const PreambleMatcher preamble_matcher,
 		const UnstuffMatcher unstuff_matcher,
-		const EndMatcher end_matcher,
-		PayloadHandlerFunc payload_handler
-	) : payload_handler { std::move(payload_handler) },
-		preamble(preamble_matcher),
+		const EndMatcher end_matcher
+	) : preamble(preamble_matcher),
 		unstuff(unstuff_matcher),
 		end(end_matcher)
 	{
@@ -71,8 +66,10 @@ public:
 		reset_state();
 	}
 
+	template<typename PayloadHandler>
 	void execute(
-		const uint_fast8_t symbol
+		const uint_fast8_t symbol,
+		PayloadHandler payload_handler
 	) {
 		bit_history.add(symbol);
 
@@ -89,13 +86,8 @@ public:
 			}
 
 			if( end(bit_history, packet.size()) ) {
-				// NOTE: This check is to avoid std::function nullptr check, which
-				// brings in "_ZSt25__throw_bad_function_callv" and a lot of extra code.
-				// TODO: Make payload_handler known at compile time.
-				if( payload_handler ) {
-					packet.set_timestamp(Timestamp::now());
-					payload_handler(packet);
-				}
+				packet.set_timestamp(Timestamp::now());
+				payload_handler(packet);
 				reset_state();
 			} else {
 				if( packet_truncated() ) {
@@ -120,8 +112,6 @@ private:
 		return packet.size() >= packet.capacity();
 	}
 
-	const PayloadHandlerFunc payload_handler;
-
 	BitHistory bit_history { };
 	PreambleMatcher preamble { };
 	UnstuffMatcher unstuff { };
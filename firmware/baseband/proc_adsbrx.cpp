@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2017 Furrtek
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "proc_adsbrx.hpp"
+
+#include "portapack_shared_memory.hpp"
+
+#include "event_m4.hpp"
+
+#include <algorithm>
+
+static void magnitude_squared(const complex8_t* src, uint16_t* dst, const size_t count) {
+	/* Two samples at a time: q1:i1:q0:i0 -> i0^2+q0^2, i1^2+q1^2 */
+	const uint32_t* src_p = reinterpret_cast<const uint32_t*>(src);
+	for(size_t n=count / 2; n>0; n--) {
+		const uint32_t q1_i1_q0_i0 = *(src_p++);
+		const uint32_t i1_i0 = __SXTB16(q1_i1_q0_i0, 0);
+		const uint32_t q1_q0 = __SXTB16(q1_i1_q0_i0, 8);
+		const uint32_t q0_i0 = __PKHBT(i1_i0, q1_q0, 16);
+		const uint32_t q1_i1 = __PKHTB(q1_q0, i1_i0, 16);
+		*(dst++) = __SMUAD(q0_i0, q0_i0);
+		*(dst++) = __SMUAD(q1_i1, q1_i1);
+	}
+}
+
+ADSBRXProcessor::BitSyndromes ADSBRXProcessor::make_bit_syndromes() {
+	BitSyndromes result { };
+	for(size_t i=0; i<result.size(); i++) {
+		adsb::ADSBFrame error { };
+		error.flip_bit(i);
+		result[i] = adsb::crc_syndrome(error.get_raw_data(), adsb::long_frame_length);
+	}
+	return result;
+}
+
+void ADSBRXProcessor::execute(const buffer_c8_t& buffer) {
+	/* 2.0MHz, 2048 samples */
+
+	size_t count = buffer.count & ~1U;
+	if( count > block_samples_max ) {
+		count = block_samples_max;
+	}
+	magnitude_squared(buffer.p, &mag[long_frame_samples], count);
+
+	size_t i = skip;
+	while(i < count) {
+		if( match_preamble(&mag[i]) ) {
+			const size_t used = decode_frame(&mag[i]);
+			if( used ) {
+				i += used;
+				continue;
+			}
+		}
+		i++;
+	}
+	skip = i - count;
+
+	std::copy(&mag[count], &mag[count + long_frame_samples], &mag[0]);
+}
+
+bool ADSBRXProcessor::match_preamble(const uint16_t* const m) {
+	/* Pulses at 0, 1.0, 3.5 and 4.5us: samples 0, 2, 7 and 9. Pulse/gap
+	 * comparisons only, cheapest (and most selective) first. */
+	if( !((m[0] > m[1]) && (m[1] < m[2]) && (m[2] > m[3]) && (m[7] > m[8]) && (m[8] < m[9])) ) {
+		return false;
+	}
+	if( !((m[3] < m[0]) && (m[4] < m[0]) && (m[5] < m[0]) && (m[6] < m[0]) && (m[9] > m[6])) ) {
+		return false;
+	}
+
+	/* Quiet zones must sit well below the pulses (~3dB under their mean) */
+	const uint32_t high = (m[0] + m[2] + m[7] + m[9]) >> 3;
+	if( (m[4] >= high) || (m[5] >= high) ) {
+		return false;
+	}
+	for(size_t n=11; n<preamble_samples - 1; n++) {
+		if( m[n] >= high ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+size_t ADSBRXProcessor::decode_frame(const uint16_t* const m) {
+	/* PPM: a one has its pulse in the first half of the bit */
+	const uint16_t* p = &m[preamble_samples];
+	size_t length = adsb::long_frame_length;
+
+	frame.clear();
+	for(size_t n=0; n<length; n++) {
+		uint8_t byte = 0;
+		for(size_t b=0; b<8; b++) {
+			byte = (byte << 1) | ((p[0] > p[1]) ? 1 : 0);
+			p += 2;
+		}
+		frame.set_byte(n, byte);
+
+		if( n == 0 ) {
+			length = frame.length();
+		}
+	}
+
+	const uint32_t syndrome = frame.syndrome();
+	switch(frame.get_DF()) {
+	case 17:
+	case 18:
+		if( (syndrome != 0) && !fix_single_bit(syndrome) ) {
+			return 0;
+		}
+		break;
+
+	case 11:
+		// All-call reply, parity may be overlaid with a 7-bit interrogator code
+		if( syndrome & ~0x7fU ) {
+			return 0;
+		}
+		break;
+
+	default:
+		// Address overlaid on parity, nothing to check it against
+		return 0;
+	}
+
+	frame.set_rx_timestamp(Timestamp::now());
+	const ADSBFrameMessage message { frame };
+	shared_memory.application_queue.push(message);
+
+	return preamble_samples + length * 8 * 2;
+}
+
+bool ADSBRXProcessor::fix_single_bit(const uint32_t syndrome) {
+	// Never touch the DF field, that would make it a different frame
+	for(size_t i=5; i<bit_syndromes.size(); i++) {
+		if( bit_syndromes[i] == syndrome ) {
+			frame.flip_bit(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+int main() {
+	EventDispatcher event_dispatcher { std::make_unique<ADSBRXProcessor>() };
+	event_dispatcher.run();
+	return 0;
+}
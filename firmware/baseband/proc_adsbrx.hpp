@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2017 Furrtek
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PROC_ADSBRX_H__
+#define __PROC_ADSBRX_H__
+
+#include "baseband_processor.hpp"
+#include "baseband_thread.hpp"
+#include "rssi_thread.hpp"
+
+#include "adsb_frame.hpp"
+
+#include "message.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+class ADSBRXProcessor : public BasebandProcessor {
+public:
+	void execute(const buffer_c8_t& buffer) override;
+
+private:
+	static constexpr size_t baseband_fs = 2000000;		// 2 samples per 1us bit
+
+	static constexpr size_t preamble_samples = 16;		// 8us
+	static constexpr size_t long_frame_samples = preamble_samples + adsb::long_frame_length * 8 * 2;
+	static constexpr size_t block_samples_max = 2048;
+
+	/* Magnitudes squared: the last frame's worth of the previous block, then
+	 * the current block, so frames straddling two DMA buffers still decode. */
+	std::array<uint16_t, long_frame_samples + block_samples_max> mag { };
+	size_t skip { 0 };
+
+	/* Syndrome of a single bit error at each position of a long frame */
+	using BitSyndromes = std::array<uint32_t, adsb::long_frame_length * 8>;
+	const BitSyndromes bit_syndromes { make_bit_syndromes() };
+
+	adsb::ADSBFrame frame { };
+
+	/* Last, the baseband thread starts calling execute() as soon as it exists */
+	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
+	RSSIThread rssi_thread { NORMALPRIO + 10 };
+
+	static BitSyndromes make_bit_syndromes();
+
+	static bool match_preamble(const uint16_t* const m);
+	size_t decode_frame(const uint16_t* const m);
+	bool fix_single_bit(const uint32_t syndrome);
+};
+
+#endif/*__PROC_ADSBRX_H__*/
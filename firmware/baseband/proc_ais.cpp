@@ -29,39 +29,61 @@
 
 AISProcessor::AISProcessor() {
 	decim_0.configure(taps_11k0_decim_0.taps, 33554432);
-	decim_1.configure(taps_11k0_decim_1.taps, 131072);
 }
 
 void AISProcessor::execute(const buffer_c8_t& buffer) {
 	/* 2.4576MHz, 2048 samples */
 
 	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
-	const auto decimator_out = decim_1_out;
 
-	/* 38.4kHz, 32 samples */
-	feed_channel_stats(decimator_out);
+	/* 307.2kHz, 256 samples, both channels */
+	feed_channel_stats(decim_0_out);
+
+	channel_a.execute(decim_0_out, work_buffer);
+	channel_b.execute(decim_0_out, work_buffer);
+}
+
+AISProcessor::Channel::Channel(
+	const ais::Channel id,
+	const int32_t shift_frequency
+) : id { id }
+{
+	translate.configure(shift_frequency, baseband_fs / 8);
+	decim_1.configure(taps_11k0_decim_1.taps, 131072);
+}
 
-	for(size_t i=0; i<decimator_out.count; i++) {
-		if( mf.execute_once(decimator_out.p[i]) ) {
-			clock_recovery(mf.get_output());
+void AISProcessor::Channel::execute(
+	const buffer_c16_t& src,
+	const buffer_c16_t& work_buffer
+) {
+	const auto translate_out = translate.execute(src, work_buffer);
+	const auto decim_1_out = decim_1.execute(translate_out, work_buffer);
+
+	/* 38.4kHz, 32 samples */
+	for(size_t i=0; i<decim_1_out.count; i++) {
+		if( mf.execute_once(decim_1_out.p[i]) ) {
+			clock_recovery(mf.get_output(), [this](const float symbol) {
+				this->consume_symbol(symbol);
+			});
 		}
 	}
 }
 
-void AISProcessor::consume_symbol(
+void AISProcessor::Channel::consume_symbol(
 	const float raw_symbol
 ) {
 	const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
 	const auto decoded_symbol = nrzi_decode(sliced_symbol);
 
-	packet_builder.execute(decoded_symbol);
+	packet_builder.execute(decoded_symbol, [this](const baseband::Packet& packet) {
+		this->payload_handler(packet);
+	});
 }
 
-void AISProcessor::payload_handler(
+void AISProcessor::Channel::payload_handler(
 	const baseband::Packet& packet
 ) {
-	const AISPacketMessage message { packet };
+	const AISPacketMessage message { id, packet };
 	shared_memory.application_queue.push(message);
 }
 
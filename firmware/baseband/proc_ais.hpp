@@ -27,6 +27,7 @@
 #include "rssi_thread.hpp"
 
 #include "channel_decimator.hpp"
+#include "dsp_translate.hpp"
 #include "matched_filter.hpp"
 
 #include "clock_recovery.hpp"
@@ -51,6 +52,9 @@ public:
 private:
 	static constexpr size_t baseband_fs = 2457600;
 
+	/* Tuned to 162.000MHz, channels are at -/+ 25kHz. */
+	static constexpr int32_t channel_offset = 25000;
+
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
@@ -60,26 +64,44 @@ private:
 		dst.size()
 	};
 
+	std::array<complex16_t, 256> work { };
+	const buffer_c16_t work_buffer {
+		work.data(),
+		work.size()
+	};
+
+	/* Shared by both channels */
 	dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
-	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
-	dsp::matched_filter::MatchedFilter mf { baseband::ais::square_taps_38k4_1t_p, 2 };
 
-	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
-		19200, 9600, { 0.0555f },
-		[this](const float symbol) { this->consume_symbol(symbol); }
-	};
-	symbol_coding::NRZIDecoder nrzi_decode { };
-	PacketBuilder<BitPattern, BitPattern, BitPattern> packet_builder {
-		{ 0b0101010101111110, 16, 1 },
-		{ 0b111110, 6 },
-		{ 0b01111110, 8 },
-		[this](const baseband::Packet& packet) {
-			this->payload_handler(packet);
-		}
+	class Channel {
+	public:
+		Channel(const ais::Channel id, const int32_t shift_frequency);
+
+		void execute(const buffer_c16_t& src, const buffer_c16_t& work_buffer);
+
+	private:
+		const ais::Channel id;
+
+		dsp::translate::TranslateC16 translate { };
+		dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
+		dsp::matched_filter::MatchedFilter mf { baseband::ais::square_taps_38k4_1t_p, 2 };
+
+		clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
+			19200, 9600, { 0.0555f }
+		};
+		symbol_coding::NRZIDecoder nrzi_decode { };
+		PacketBuilder<BitPattern, BitPattern, BitPattern> packet_builder {
+			{ 0b0101010101111110, 16, 1 },
+			{ 0b111110, 6 },
+			{ 0b01111110, 8 }
+		};
+
+		void consume_symbol(const float symbol);
+		void payload_handler(const baseband::Packet& packet);
 	};
 
-	void consume_symbol(const float symbol);
-	void payload_handler(const baseband::Packet& packet);
+	Channel channel_a { ais::Channel::A_87B,  channel_offset };
+	Channel channel_b { ais::Channel::B_88B, -channel_offset };
 };
 
 #endif/*__PROC_AIS_H__*/
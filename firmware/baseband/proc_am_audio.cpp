@@ -23,6 +23,8 @@
 
 #include "audio_output.hpp"
 
+#include "portapack_shared_memory.hpp"
+
 #include "event_m4.hpp"
 
 #include <array>
@@ -32,9 +34,8 @@ void NarrowbandAMAudio::execute(const buffer_c8_t& buffer) {
 		return;
 	}
 
-	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
-	const auto decim_2_out = decim_2.execute(decim_1_out, dst_buffer);
+	const auto decim_out = decim.execute(buffer);
+	const auto decim_2_out = decim_2.execute(decim_out, dst_buffer);
 	const auto channel_out = channel_filter.execute(decim_2_out, dst_buffer);
 
 	// TODO: Feed channel_stats post-decimation data?
@@ -47,20 +48,48 @@ void NarrowbandAMAudio::execute(const buffer_c8_t& buffer) {
 }
 
 buffer_f32_t NarrowbandAMAudio::demodulate(const buffer_c16_t& channel) {
-	if( modulation_ssb ) {
+	switch(modulation) {
+	case AMConfigureMessage::Modulation::SSB:
 		return demod_ssb.execute(channel, audio_buffer);
-	} else {
+
+	case AMConfigureMessage::Modulation::SAM:
+		feed_carrier(channel.count);
+		return demod_sam.execute(channel, audio_buffer);
+
+	case AMConfigureMessage::Modulation::DSB:
+	default:
 		return demod_am.execute(channel, audio_buffer);
 	}
 }
 
+void NarrowbandAMAudio::feed_carrier(const size_t count) {
+	carrier_samples += count;
+	if( carrier_samples >= carrier_interval_samples ) {
+		carrier_samples -= carrier_interval_samples;
+
+		const AMCarrierMessage message {
+			static_cast<int32_t>(demod_sam.carrier_offset_hz()),
+			demod_sam.locked()
+		};
+		shared_memory.application_queue.push(message);
+	}
+}
+
 void NarrowbandAMAudio::on_message(const Message* const message) {
 	switch(message->id) {
 	case Message::ID::UpdateSpectrum:
+		channel_spectrum.on_message(message);
+		audio_output.on_message(message);
+		break;
+
 	case Message::ID::SpectrumStreamingConfig:
 		channel_spectrum.on_message(message);
 		break;
 
+	case Message::ID::AudioSpectrumStreamingConfig:
+		audio_output.on_message(message);
+		break;
+
 	case Message::ID::AMConfigure:
 		configure(*reinterpret_cast<const AMConfigureMessage*>(message));
 		break;
@@ -75,27 +104,24 @@ void NarrowbandAMAudio::on_message(const Message* const message) {
 }
 
 void NarrowbandAMAudio::configure(const AMConfigureMessage& message) {
-	constexpr size_t decim_0_input_fs = baseband_fs;
-	constexpr size_t decim_0_output_fs = decim_0_input_fs / decim_0.decimation_factor;
-
-	constexpr size_t decim_1_input_fs = decim_0_output_fs;
-	constexpr size_t decim_1_output_fs = decim_1_input_fs / decim_1.decimation_factor;
-
-	constexpr size_t decim_2_input_fs = decim_1_output_fs;
+	constexpr size_t decim_2_input_fs = decim_t::output_sampling_rate;
 	constexpr size_t decim_2_output_fs = decim_2_input_fs / decim_2_decimation_factor;
 
 	constexpr size_t channel_filter_input_fs = decim_2_output_fs;
 	const size_t channel_filter_output_fs = channel_filter_input_fs / channel_filter_decimation_factor;
 
-	decim_0.configure(message.decim_0_filter.taps, 33554432);
-	decim_1.configure(message.decim_1_filter.taps, 131072);
+	decim.stage<0>().configure(message.decim_0_filter.taps, 33554432);
+	decim.stage<1>().configure(message.decim_1_filter.taps, 131072);
 	decim_2.configure(message.decim_2_filter.taps, decim_2_decimation_factor);
 	channel_filter.configure(message.channel_filter.taps, channel_filter_decimation_factor);
 	channel_filter_pass_f = message.channel_filter.pass_frequency_normalized * channel_filter_input_fs;
 	channel_filter_stop_f = message.channel_filter.stop_frequency_normalized * channel_filter_input_fs;
 	channel_spectrum.set_decimation_factor(std::floor(channel_filter_output_fs / (channel_filter_pass_f + channel_filter_stop_f)));
-	modulation_ssb = (message.modulation == AMConfigureMessage::Modulation::SSB);
-	audio_output.configure(message.audio_hpf_config);
+	modulation = message.modulation;
+	demod_sam.configure(channel_filter_output_fs);
+	carrier_interval_samples = channel_filter_output_fs / carrier_rate_hz;
+	carrier_samples = 0;
+	audio_output.configure(message.audio_hpf_config, iir_config_passthrough, message.squelch_level);
 
 	configured = true;
 }
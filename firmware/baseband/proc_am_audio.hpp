@@ -26,7 +26,10 @@
 #include "baseband_thread.hpp"
 #include "rssi_thread.hpp"
 
+#include "baseband_dma.hpp"
+
 #include "dsp_decimate.hpp"
+#include "dsp_pipeline.hpp"
 #include "dsp_demodulate.hpp"
 #include "audio_compressor.hpp"
 
@@ -45,31 +48,36 @@ private:
 	static constexpr size_t baseband_fs = 3072000;
 	static constexpr size_t decim_2_decimation_factor = 4;
 	static constexpr size_t channel_filter_decimation_factor = 1;
+	static constexpr auto carrier_rate_hz = 4.0f;
 
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
-	std::array<complex16_t, 512> dst { };
-	const buffer_c16_t dst_buffer {
-		dst.data(),
-		dst.size()
-	};
+	using decim_t = dsp::pipeline::Pipeline<
+		baseband_fs, baseband::dma::transfer_samples,
+		dsp::decimate::FIRC8xR16x24FS4Decim8,
+		dsp::decimate::FIRC16xR16x32Decim8
+	>;
+
+	decim_t decim { };
+	const buffer_c16_t dst_buffer { decim.scratch<complex16_t>() };
 	std::array<float, 32> audio { };
 	const buffer_f32_t audio_buffer {
 		audio.data(),
 		audio.size()
 	};
 
-	dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
-	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
 	dsp::decimate::FIRAndDecimateComplex decim_2 { };
 	dsp::decimate::FIRAndDecimateComplex channel_filter { };
 	uint32_t channel_filter_pass_f = 0;
 	uint32_t channel_filter_stop_f = 0;
 
-	bool modulation_ssb = false;
+	AMConfigureMessage::Modulation modulation { AMConfigureMessage::Modulation::DSB };
 	dsp::demodulate::AM demod_am { };
 	dsp::demodulate::SSB demod_ssb { };
+	dsp::demodulate::SAM demod_sam { };
+	size_t carrier_interval_samples = 0;
+	size_t carrier_samples = 0;
 	FeedForwardCompressor audio_compressor { };
 	AudioOutput audio_output { };
 
@@ -80,6 +88,7 @@ private:
 	void capture_config(const CaptureConfigMessage& message);
 
 	buffer_f32_t demodulate(const buffer_c16_t& channel);
+	void feed_carrier(const size_t count);
 };
 
 #endif/*__PROC_AM_AUDIO_H__*/
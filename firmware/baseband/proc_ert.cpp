@@ -25,46 +25,33 @@
 
 #include "event_m4.hpp"
 
-float ERTProcessor::abs(const complex8_t& v) {
-	// const int16_t r = v.real() - offset_i;
-	// const int16_t i = v.imag() - offset_q;
-	// const uint32_t r2 = r * r;
-	// const uint32_t i2 = i * i;
-	// const uint32_t r2_i2 = r2 + i2;
-	// return std::sqrt(static_cast<float>(r2_i2));
-	const float r = static_cast<float>(v.real()) - offset_i;
-	const float i = static_cast<float>(v.imag()) - offset_q;
-	const float r2 = r * r;
-	const float i2 = i * i;
-	const float r2_i2 = r2 + i2;
-	return std::sqrt(r2_i2);
-}
+#include <cmath>
 
 void ERTProcessor::execute(const buffer_c8_t& buffer) {
 	/* 4.194304MHz, 2048 samples */
 
-	const complex8_t* src = &buffer.p[0];
-	const complex8_t* const src_end = &buffer.p[buffer.count];
-
-	average_i += src->real();
-	average_q += src->imag();
-	average_count++;
-	if( average_count == average_window ) {
-		offset_i = static_cast<float>(average_i) / average_window;
-		offset_q = static_cast<float>(average_q) / average_window;
-		average_i = 0;
-		average_q = 0;
-		average_count = 0;
-	}
+	iq_correction.update(buffer);
+	envelope.set_offset(
+		std::lround(iq_correction.dc_i()),
+		std::lround(iq_correction.dc_q())
+	);
+
+	const auto envelope_out = envelope.execute(buffer, mag_buffer);
 
 	const float gain = 128 * samples_per_symbol;
 	const float k = 1.0f / gain;
 
-	while(src < src_end) {
-		float sum = 0.0f;
-		for(size_t i=0; i<(samples_per_symbol / 2); i++) {
-			sum += abs(*(src++));
+	/* Two magnitudes summed per SMLAD */
+	const uint32_t* mag_p = reinterpret_cast<const uint32_t*>(envelope_out.p);
+	const uint32_t* const mag_end = reinterpret_cast<const uint32_t*>(&envelope_out.p[envelope_out.count]);
+
+	while(mag_p < mag_end) {
+		int32_t sum_int = 0;
+		for(size_t i=0; i<(samples_per_symbol / 4); i++) {
+			sum_int = __SMLAD(*(mag_p++), 0x00010001, sum_int);
 		}
+		const float sum = sum_int;
+
 		sum_half_period[1] = sum_half_period[0];
 		sum_half_period[0] = sum;
 
@@ -78,7 +65,9 @@ void ERTProcessor::execute(const buffer_c8_t& buffer) {
 
 		const auto data = manchester[0] - manchester[2];
 
-		clock_recovery(data);
+		clock_recovery(data, [this](const float symbol) {
+			this->consume_symbol(symbol);
+		});
 	}
 }
 
@@ -86,8 +75,12 @@ void ERTProcessor::consume_symbol(
 	const float raw_symbol
 ) {
 	const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
-	scm_builder.execute(sliced_symbol);
-	idm_builder.execute(sliced_symbol);
+	scm_builder.execute(sliced_symbol, [this](const baseband::Packet& packet) {
+		this->scm_handler(packet);
+	});
+	idm_builder.execute(sliced_symbol, [this](const baseband::Packet& packet) {
+		this->idm_handler(packet);
+	});
 }
 
 void ERTProcessor::scm_handler(
@@ -27,6 +27,8 @@
 #include "rssi_thread.hpp"
 
 #include "channel_decimator.hpp"
+#include "dsp_envelope.hpp"
+#include "dsp_iq_correction.hpp"
 
 #include "clock_recovery.hpp"
 #include "symbol_coding.hpp"
@@ -38,6 +40,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <bitset>
+#include <array>
 
 // ''.join(['%d%d' % (c, 1-c) for c in map(int, bin(0x1f2a60)[2:].zfill(21))])
 constexpr uint64_t scm_preamble_and_sync_manchester { 0b101010101001011001100110010110100101010101 };
@@ -67,26 +70,19 @@ private:
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
 	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
-		clock_recovery_rate, symbol_rate, { 1.0f / 18.0f },
-		[this](const float symbol) { this->consume_symbol(symbol); }
+		clock_recovery_rate, symbol_rate, { 1.0f / 18.0f }
 	};
 
 	PacketBuilder<BitPattern, NeverMatch, FixedLength> scm_builder {
 		{ scm_preamble_and_sync_manchester, scm_preamble_and_sync_length, 1 },
 		{ },
-		{ scm_payload_length_max },
-		[this](const baseband::Packet& packet) {
-			this->scm_handler(packet);
-		}
+		{ scm_payload_length_max }
 	};
 
 	PacketBuilder<BitPattern, NeverMatch, FixedLength> idm_builder {
 		{ idm_preamble_and_sync_manchester, idm_preamble_and_sync_length, 1 },
 		{ },
-		{ idm_payload_length_max },
-		[this](const baseband::Packet& packet) {
-			this->idm_handler(packet);
-		}
+		{ idm_payload_length_max }
 	};
 
 	void consume_symbol(const float symbol);
@@ -97,14 +93,14 @@ private:
 	float sum_period[3];
 	float manchester[3];
 
-	const size_t average_window { 2048 };
-	int32_t average_i { 0 };
-	int32_t average_q { 0 };
-	size_t average_count { 0 };
-	float offset_i { 0.0f };
-	float offset_q { 0.0f };
+	dsp::iq_correction::IQCorrection iq_correction { };
 
-	float abs(const complex8_t& v);
+	dsp::envelope::MagnitudeC8 envelope { };
+	std::array<uint16_t, 2048> mag { };
+	const buffer_u16_t mag_buffer {
+		mag.data(),
+		mag.size()
+	};
 };
 
 #endif/*__PROC_ERT_H__*/
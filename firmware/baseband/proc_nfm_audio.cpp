@@ -24,6 +24,8 @@
 
 #include "event_m4.hpp"
 
+#include "portapack_shared_memory.hpp"
+
 #include <cstdint>
 #include <cstddef>
 
@@ -32,15 +34,17 @@ void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
 		return;
 	}
 	
-	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-	const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
-	const auto channel_out = channel_filter.execute(decim_1_out, dst_buffer);
+	const auto decim_out = decim.execute(buffer);
+	const auto channel_out = channel_filter.execute(decim_out, dst_buffer);
 
 	feed_channel_stats(channel_out);
 	channel_spectrum.feed(channel_out, channel_filter_pass_f, channel_filter_stop_f);
 
 	if (!pwmrssi_enabled) {
 		auto audio = demod.execute(channel_out, audio_buffer);
+		subtone_detector.feed(audio, [this](const Subtone& detected) {
+			this->on_subtone(detected);
+		});
 		audio_output.write(audio);
 	} else {
 		for (c = 0; c < 32; c++) {
@@ -62,10 +66,18 @@ void NarrowbandFMAudio::execute(const buffer_c8_t& buffer) {
 void NarrowbandFMAudio::on_message(const Message* const message) {
 	switch(message->id) {
 	case Message::ID::UpdateSpectrum:
+		channel_spectrum.on_message(message);
+		audio_output.on_message(message);
+		break;
+
 	case Message::ID::SpectrumStreamingConfig:
 		channel_spectrum.on_message(message);
 		break;
 
+	case Message::ID::AudioSpectrumStreamingConfig:
+		audio_output.on_message(message);
+		break;
+
 	case Message::ID::NBFMConfigure:
 		configure(*reinterpret_cast<const NBFMConfigureMessage*>(message));
 		break;
@@ -77,6 +89,10 @@ void NarrowbandFMAudio::on_message(const Message* const message) {
 	case Message::ID::PWMRSSIConfigure:
 		pwmrssi_config(*reinterpret_cast<const PWMRSSIConfigureMessage*>(message));
 		break;
+
+	case Message::ID::SubtoneConfig:
+		subtone_config(*reinterpret_cast<const SubtoneConfigMessage*>(message));
+		break;
 		
 	default:
 		break;
@@ -84,25 +100,20 @@ void NarrowbandFMAudio::on_message(const Message* const message) {
 }
 
 void NarrowbandFMAudio::configure(const NBFMConfigureMessage& message) {
-	constexpr size_t decim_0_input_fs = baseband_fs;
-	constexpr size_t decim_0_output_fs = decim_0_input_fs / decim_0.decimation_factor;
-
-	constexpr size_t decim_1_input_fs = decim_0_output_fs;
-	constexpr size_t decim_1_output_fs = decim_1_input_fs / decim_1.decimation_factor;
-
-	constexpr size_t channel_filter_input_fs = decim_1_output_fs;
+	constexpr size_t channel_filter_input_fs = decim_t::output_sampling_rate;
 	const size_t channel_filter_output_fs = channel_filter_input_fs / message.channel_decimation;
 
 	const size_t demod_input_fs = channel_filter_output_fs;
 
-	decim_0.configure(message.decim_0_filter.taps, 33554432);
-	decim_1.configure(message.decim_1_filter.taps, 131072);
+	decim.stage<0>().configure(message.decim_0_filter.taps, 33554432);
+	decim.stage<1>().configure(message.decim_1_filter.taps, 131072);
 	channel_filter.configure(message.channel_filter.taps, message.channel_decimation);
 	demod.configure(demod_input_fs, message.deviation);
 	channel_filter_pass_f = message.channel_filter.pass_frequency_normalized * channel_filter_input_fs;
 	channel_filter_stop_f = message.channel_filter.stop_frequency_normalized * channel_filter_input_fs;
 	channel_spectrum.set_decimation_factor(std::floor(channel_filter_output_fs / (channel_filter_pass_f + channel_filter_stop_f)));
-	audio_output.configure(message.audio_hpf_config, message.audio_deemph_config);	// , 0.8f
+	audio_output.configure(message.audio_hpf_config, message.audio_deemph_config, message.squelch_level);
+	subtone_detector.configure(demod_input_fs);
 	
 	synth_acc = 0;
 	
@@ -116,6 +127,21 @@ void NarrowbandFMAudio::pwmrssi_config(const PWMRSSIConfigureMessage& message) {
 	synth_acc = 0;
 }
 
+void NarrowbandFMAudio::subtone_config(const SubtoneConfigMessage& message) {
+	subtone_gate = message.gate;
+	// Stay closed until the detector reports a match.
+	audio_output.set_gate(subtone_gate.type == Subtone::Type::None);
+}
+
+void NarrowbandFMAudio::on_subtone(const Subtone& detected) {
+	if( subtone_gate.type != Subtone::Type::None ) {
+		audio_output.set_gate(detected == subtone_gate);
+	}
+
+	const SubtoneMessage subtone_message { detected };
+	shared_memory.application_queue.push(subtone_message);
+}
+
 void NarrowbandFMAudio::capture_config(const CaptureConfigMessage& message) {
 	if( message.config ) {
 		audio_output.set_stream(std::make_unique<StreamInput>(message.config));
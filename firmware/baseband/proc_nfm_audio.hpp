@@ -27,10 +27,14 @@
 #include "baseband_thread.hpp"
 #include "rssi_thread.hpp"
 
+#include "baseband_dma.hpp"
+
 #include "dsp_decimate.hpp"
 #include "dsp_demodulate.hpp"
+#include "dsp_pipeline.hpp"
 
 #include "audio_output.hpp"
+#include "subtone_detector.hpp"
 #include "spectrum_collector.hpp"
 
 #include <cstdint>
@@ -47,11 +51,14 @@ private:
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
-	std::array<complex16_t, 512> dst { };
-	const buffer_c16_t dst_buffer {
-		dst.data(),
-		dst.size()
-	};
+	using decim_t = dsp::pipeline::Pipeline<
+		baseband_fs, baseband::dma::transfer_samples,
+		dsp::decimate::FIRC8xR16x24FS4Decim8,
+		dsp::decimate::FIRC16xR16x32Decim8
+	>;
+
+	decim_t decim { };
+	const buffer_c16_t dst_buffer { decim.scratch<complex16_t>() };
 	std::array<float, 32> audio { };
 	const buffer_f32_t audio_buffer {
 		audio.data(),
@@ -64,8 +71,6 @@ private:
 		sizeof(pwm) / sizeof(int16_t)
 	};
 
-	dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0 { };
-	dsp::decimate::FIRC16xR16x32Decim8 decim_1 { };
 	dsp::decimate::FIRAndDecimateComplex channel_filter { };
 	uint32_t channel_filter_pass_f = 0;
 	uint32_t channel_filter_stop_f = 0;
@@ -74,6 +79,9 @@ private:
 
 	AudioOutput audio_output { };
 
+	SubtoneDetector subtone_detector { };
+	Subtone subtone_gate { };
+
 	SpectrumCollector channel_spectrum { };
 	
 	unsigned int c { 0 }, synth_acc { 0 };
@@ -85,6 +93,8 @@ private:
 	void pwmrssi_config(const PWMRSSIConfigureMessage& message);
 	void configure(const NBFMConfigureMessage& message);
 	void capture_config(const CaptureConfigMessage& message);
+	void subtone_config(const SubtoneConfigMessage& message);
+	void on_subtone(const Subtone& detected);
 };
 
 #endif/*__PROC_NFM_AUDIO_H__*/
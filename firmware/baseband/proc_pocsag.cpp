@@ -24,6 +24,7 @@
 
 #include "proc_pocsag.hpp"
 
+#include "bch_code.hpp"
 #include "event_m4.hpp"
 
 #include <cstdint>
@@ -49,88 +50,101 @@ void POCSAGProcessor::execute(const buffer_c8_t& buffer) {
 		slicer_sr <<= 1;
 		slicer_sr |= (audio_sample < 0);		// Do we need hysteresis ?
 
-		// Detect transitions to adjust clock
-		if ((slicer_sr ^ (slicer_sr >> 1)) & 1) {
-			if (sphase < (0x8000u - sphase_delta_half))
-				sphase += sphase_delta_eighth;
-			else
-				sphase -= sphase_delta_eighth;
-		}
+		for (auto& decoder : decoders)
+			decoder.execute(slicer_sr);
+	}
+}
+
+void POCSAGProcessor::BitRateDecoder::reset() {
+	sphase = 0;
+	rx_data = 0;
+	rx_state = WAITING;
+}
+
+void POCSAGProcessor::BitRateDecoder::execute(const uint32_t slicer_sr) {
+	// Detect transitions to adjust clock
+	if ((slicer_sr ^ (slicer_sr >> 1)) & 1) {
+		if (sphase < (0x8000u - sphase_delta_half))
+			sphase += sphase_delta_eighth;
+		else
+			sphase -= sphase_delta_eighth;
+	}
+	
+	sphase += sphase_delta;
+	
+	// Symbol time elapsed
+	if (sphase < 0x10000u)
+		return;
+
+	sphase &= 0xFFFFu;
+	
+	rx_data <<= 1;
+	rx_data |= (slicer_sr & 1);
+	
+	switch (rx_state) {
 		
-		sphase += sphase_delta;
+		case WAITING:
+			if (rx_data == 0xAAAAAAAA) {
+				rx_state = PREAMBLE;
+				sync_timeout = 0;
+			}
+			break;
 		
-		// Symbol time elapsed
-		if (sphase >= 0x10000u) {
-			sphase &= 0xFFFFu;
-			
-			rx_data <<= 1;
-			rx_data |= (slicer_sr & 1);
-			
-			switch (rx_state) {
-				
-				case WAITING:
-					if (rx_data == 0xAAAAAAAA) {
-						rx_state = PREAMBLE;
-						sync_timeout = 0;
-					}
-					break;
+		case PREAMBLE:
+			if (sync_timeout < POCSAG_TIMEOUT) {
+				sync_timeout++;
+
+				if (rx_data == POCSAG_SYNCWORD) {
+					packet.clear();
+					codeword_count = 0;
+					rx_bit = 0;
+					msg_timeout = 0;
+					rx_state = SYNC;
+				}
 				
-				case PREAMBLE:
-					if (sync_timeout < POCSAG_TIMEOUT) {
-						sync_timeout++;
-
-						if (rx_data == POCSAG_SYNCWORD) {
-							packet.clear();
-							codeword_count = 0;
-							rx_bit = 0;
-							msg_timeout = 0;
-							rx_state = SYNC;
-						}
-						
-					} else {
-						// Timeout here is normal (end of message)
-						rx_state = WAITING;
-						//push_packet(pocsag::PacketFlag::TIMED_OUT);
-					}
-					break;
+			} else {
+				// Timeout here is normal (end of message)
+				rx_state = WAITING;
+				//push_packet(pocsag::PacketFlag::TIMED_OUT);
+			}
+			break;
+		
+		case SYNC:
+			if (msg_timeout < POCSAG_BATCH_LENGTH) {
+				msg_timeout++;
+				rx_bit++;
 				
-				case SYNC:
-					if (msg_timeout < POCSAG_BATCH_LENGTH) {
-						msg_timeout++;
-						rx_bit++;
-						
-						if (rx_bit >= 32) {
-							rx_bit = 0;
-							
-							// Got a complete codeword
-							
-							//pocsag_brute_repair(&s->l2.pocsag, &rx_data);
-							
-							packet.set(codeword_count, rx_data);
-							
-							if (codeword_count < 15) {
-								codeword_count++;
-							} else {
-								push_packet(pocsag::PacketFlag::NORMAL);
-								rx_state = PREAMBLE;
-								sync_timeout = 0;
-							}
-						}
+				if (rx_bit >= 32) {
+					rx_bit = 0;
+					
+					// Got a complete codeword
+					
+					// Up to two bit errors (plus parity) are fixed, worse is passed on as is
+					BCHCode::correct(rx_data);
+					
+					packet.set(codeword_count, rx_data);
+					
+					if (codeword_count < 15) {
+						codeword_count++;
 					} else {
-						packet.set(0, codeword_count);	// Replace first codeword with count, for debug
-						push_packet(pocsag::PacketFlag::TIMED_OUT);
-						rx_state = WAITING;
+						push_packet(pocsag::PacketFlag::NORMAL);
+						rx_state = PREAMBLE;
+						sync_timeout = 0;
 					}
-					break;
-
-				default:
-					break;
+				}
+			} else {
+				packet.set(0, codeword_count);	// Replace first codeword with count, for debug
+				push_packet(pocsag::PacketFlag::TIMED_OUT);
+				rx_state = WAITING;
 			}
-		}
+			break;
+
+		default:
+			break;
 	}
 }
 
-void POCSAGProcessor::push_packet(pocsag::PacketFlag flag) {
+void POCSAGProcessor::BitRateDecoder::push_packet(pocsag::PacketFlag flag) {
 	packet.set_bitrate(bitrate);
 	packet.set_flag(flag);
 	packet.set_timestamp(Timestamp::now());
@@ -143,7 +157,7 @@ void POCSAGProcessor::on_message(const Message* const message) {
 		configure(*reinterpret_cast<const POCSAGConfigureMessage*>(message));
 }
 
-void POCSAGProcessor::configure(const POCSAGConfigureMessage& message) {
+void POCSAGProcessor::configure(const POCSAGConfigureMessage&) {
 	constexpr size_t decim_0_input_fs = baseband_fs;
 	constexpr size_t decim_0_output_fs = decim_0_input_fs / decim_0.decimation_factor;
 
@@ -161,12 +175,9 @@ void POCSAGProcessor::configure(const POCSAGConfigureMessage& message) {
 	demod.configure(demod_input_fs, 4500);
 	//audio_output.configure(false);
 
-	bitrate = message.bitrate;
-	sphase_delta = 0x10000u * bitrate / POCSAG_AUDIO_RATE;
-	sphase_delta_half = sphase_delta / 2;			// Just for speed
-	sphase_delta_eighth = sphase_delta / 8;
+	for (auto& decoder : decoders)
+		decoder.reset();
 	
-	rx_state = WAITING;
 	configured = true;
 }
 
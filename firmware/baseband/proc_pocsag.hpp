@@ -59,6 +59,41 @@ private:
 		//END_OF_MESSAGE = 69
 	};
 
+	/* Symbol sync and framing for one bit rate. All bit rates run in
+	 * parallel on the same sliced audio. */
+	class BitRateDecoder {
+	public:
+		BitRateDecoder(
+			const pocsag::BitRate bitrate
+		) : bitrate { bitrate },
+			sphase_delta { 0x10000u * bitrate / POCSAG_AUDIO_RATE },
+			sphase_delta_half { sphase_delta / 2 },
+			sphase_delta_eighth { sphase_delta / 8 }
+		{
+		}
+
+		void reset();
+		void execute(const uint32_t slicer_sr);
+
+	private:
+		const pocsag::BitRate bitrate;
+		const uint32_t sphase_delta;
+		const uint32_t sphase_delta_half;
+		const uint32_t sphase_delta_eighth;
+
+		uint32_t sync_timeout { 0 };
+		uint32_t msg_timeout { 0 };
+
+		uint32_t sphase { 0 };
+		uint32_t rx_data { 0 };
+		uint32_t rx_bit { 0 };
+		rx_states rx_state { WAITING };
+		uint32_t codeword_count { 0 };
+		pocsag::POCSAGPacket packet { };
+
+		void push_packet(pocsag::PacketFlag flag);
+	};
+
 	static constexpr size_t baseband_fs = 3072000;
 
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
@@ -82,25 +117,16 @@ private:
 	
 	//AudioOutput audio_output { };
 
-	uint32_t sync_timeout { 0 };
-	uint32_t msg_timeout { 0 };
-
 	uint32_t slicer_sr { 0 };
-	uint32_t sphase { 0 };
-	uint32_t sphase_delta { 0 };
-	uint32_t sphase_delta_half { 0 };
-	uint32_t sphase_delta_eighth { 0 };
-	uint32_t rx_data { 0 };
-	uint32_t rx_bit { 0 };
 	bool configured = false;
-	rx_states rx_state { WAITING };
-	pocsag::BitRate bitrate { pocsag::BitRate::FSK1200 };
-	uint32_t codeword_count { 0 };
-	pocsag::POCSAGPacket packet { };
-	
-	void push_packet(pocsag::PacketFlag flag);
+
+	std::array<BitRateDecoder, 3> decoders { {
+		{ pocsag::BitRate::FSK512 },
+		{ pocsag::BitRate::FSK1200 },
+		{ pocsag::BitRate::FSK2400 },
+	} };
+
 	void configure(const POCSAGConfigureMessage& message);
-	
 };
 
 #endif/*__PROC_POCSAG_H__*/
@@ -41,19 +41,34 @@ void TPMSProcessor::execute(const buffer_c8_t& buffer) {
 
 	for(size_t i=0; i<decimator_out.count; i++) {
 		if( mf_38k4_1t_19k2.execute_once(decimator_out.p[i]) ) {
-			clock_recovery_fsk_19k2(mf_38k4_1t_19k2.get_output());
+			clock_recovery_fsk_19k2(mf_38k4_1t_19k2.get_output(), [this](const float raw_symbol) {
+				const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
+				this->packet_builder_fsk_19k2_schrader.execute(sliced_symbol,
+					[](const baseband::Packet& packet) {
+						payload_handler<tpms::SignalType::FSK_19k2_Schrader>(packet);
+					}
+				);
+			});
 		}
 	}
 
 	for(size_t i=0; i<decimator_out.count; i+=channel_decimation) {
-		const auto sliced = ook_slicer_5sps(decimator_out.p[i]);
+		const auto sliced = ook_slicer_5sps(ook_envelope.execute_once(decimator_out.p[i]));
 		slicer_history = (slicer_history << 1) | sliced;
 
 		clock_recovery_ook_8k192(slicer_history, [this](const bool symbol) {
-			this->packet_builder_ook_8k192_schrader.execute(symbol);
+			this->packet_builder_ook_8k192_schrader.execute(symbol,
+				[](const baseband::Packet& packet) {
+					payload_handler<tpms::SignalType::OOK_8k192_Schrader>(packet);
+				}
+			);
 		});
 		clock_recovery_ook_8k4(slicer_history, [this](const bool symbol) {
-			this->packet_builder_ook_8k4_schrader.execute(symbol);
+			this->packet_builder_ook_8k4_schrader.execute(symbol,
+				[](const baseband::Packet& packet) {
+					payload_handler<tpms::SignalType::OOK_8k4_Schrader>(packet);
+				}
+			);
 		});
 	}
 }
@@ -28,6 +28,7 @@
 
 #include "channel_decimator.hpp"
 #include "matched_filter.hpp"
+#include "dsp_envelope.hpp"
 
 #include "clock_recovery.hpp"
 #include "symbol_coding.hpp"
@@ -81,25 +82,18 @@ private:
 	dsp::matched_filter::MatchedFilter mf_38k4_1t_19k2 { rect_taps_307k2_38k4_1t_19k2_p, 8 };
 
 	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery_fsk_19k2 {
-		38400, 19200, { 0.0555f },
-		[this](const float raw_symbol) {
-			const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
-			this->packet_builder_fsk_19k2_schrader.execute(sliced_symbol);
-		}
+		38400, 19200, { 0.0555f }
 	};
 	PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_19k2_schrader {
 		{ 0b010101010101010101010101010110, 30, 1 },
 		{ },
-		{ 160 },
-		[this](const baseband::Packet& packet) {
-			const TPMSPacketMessage message { tpms::SignalType::FSK_19k2_Schrader, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ 160 }
 	};
 
 	static constexpr float channel_rate_in = 307200.0f;
 	static constexpr size_t channel_decimation = 2;
 	static constexpr float channel_sample_rate = channel_rate_in / channel_decimation;
+	dsp::envelope::MagSquaredC16 ook_envelope { };
 	OOKSlicerMagSquaredInt ook_slicer_5sps { channel_sample_rate / 8400 + 1};
 	uint32_t slicer_history { 0 };
 
@@ -114,11 +108,7 @@ private:
 		 */
 		{ 0b010101010101010101011110, 24, 0 },
 		{ },
-		{ 37 * 2 },
-		[](const baseband::Packet& packet) {
-			const TPMSPacketMessage message { tpms::SignalType::OOK_8k192_Schrader, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ 37 * 2 }
 	};
 
 	OOKClockRecovery clock_recovery_ook_8k4 {
@@ -132,12 +122,14 @@ private:
 		 */
 		{ 0b01010101010101010101010101100101, 32, 0 },
 		{ },
-		{ 76 * 2 },
-		[](const baseband::Packet& packet) {
-			const TPMSPacketMessage message { tpms::SignalType::OOK_8k4_Schrader, packet };
-			shared_memory.application_queue.push(message);
-		}
+		{ 76 * 2 }
 	};
+
+	template<tpms::SignalType signal_type>
+	static void payload_handler(const baseband::Packet& packet) {
+		const TPMSPacketMessage message { signal_type, packet };
+		shared_memory.application_queue.push(message);
+	}
 };
 
 #endif/*__PROC_TPMS_H__*/
@@ -26,6 +26,8 @@
 
 #include "event_m4.hpp"
 
+#include "portapack_shared_memory.hpp"
+
 #include <cstdint>
 
 void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
@@ -33,8 +35,7 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 		return;
 	}
 	
-	const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-	const auto channel = decim_1.execute(decim_0_out, dst_buffer);
+	const auto channel = decim.execute(buffer);
 
 	// TODO: Feed channel_stats post-decimation data?
 	feed_channel_stats(channel);
@@ -60,18 +61,27 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 		 * -> 192kHz int16_t[128] */
 		auto audio_4fs = audio_dec_1.execute(audio_oversampled, work_audio_buffer);
 
+		/* 192kHz int16_t[128] multiplex
+		 * -> 19kHz pilot PLL
+		 * -> 192kHz int16_t[128] (L-R)/2, 12kHz complex32_t[8] RDS */
+		stereo.execute(audio_4fs, difference_buffer, rds_buffer);
+		rds_decoder.execute({ rds_buffer.p, stereo.rds_count(), audio_4fs.sampling_rate / dsp::demodulate::FMStereo::rds_decimation });
+		send_status(audio_4fs.count);
+
 		/* 192kHz int16_t[128]
 		 * -> 4th order CIC decimation by 2, gain of 1
 		 * -> 96kHz int16_t[64] */
 		auto audio_2fs = audio_dec_2.execute(audio_4fs, work_audio_buffer);
+		auto difference_2fs = difference_dec.execute({ difference_buffer.p, audio_4fs.count, audio_4fs.sampling_rate }, difference_buffer);
 
 		/* 96kHz int16_t[64]
 		 * -> FIR filter, <15kHz (0.156fs) pass, >19kHz (0.198fs) stop, gain of 1
 		 * -> 48kHz int16_t[32] */
 		auto audio = audio_filter.execute(audio_2fs, work_audio_buffer);
+		auto audio_difference = difference_filter.execute(difference_2fs, difference_buffer);
 
-		/* -> 48kHz int16_t[32] */
-		audio_output.write(audio);
+		/* -> 48kHz int16_t[32] L+R, L-R */
+		audio_output.write(audio, audio_difference);
 	} else {
 		for (c = 0; c < 32; c++) {
 			if (synth_acc < pwmrssi_avg)
@@ -94,10 +104,18 @@ void WidebandFMAudio::execute(const buffer_c8_t& buffer) {
 void WidebandFMAudio::on_message(const Message* const message) {
 	switch(message->id) {
 	case Message::ID::UpdateSpectrum:
+		channel_spectrum.on_message(message);
+		audio_output.on_message(message);
+		break;
+
 	case Message::ID::SpectrumStreamingConfig:
 		channel_spectrum.on_message(message);
 		break;
 
+	case Message::ID::AudioSpectrumStreamingConfig:
+		audio_output.on_message(message);
+		break;
+
 	case Message::ID::WFMConfigure:
 		configure(*reinterpret_cast<const WFMConfigureMessage*>(message));
 		break;
@@ -116,24 +134,31 @@ void WidebandFMAudio::on_message(const Message* const message) {
 }
 
 void WidebandFMAudio::configure(const WFMConfigureMessage& message) {
-	constexpr size_t decim_0_input_fs = baseband_fs;
-	constexpr size_t decim_0_output_fs = decim_0_input_fs / decim_0.decimation_factor;
-
-	constexpr size_t decim_1_input_fs = decim_0_output_fs;
-	constexpr size_t decim_1_output_fs = decim_1_input_fs / decim_1.decimation_factor;
+	constexpr size_t decim_1_input_fs = decim_t::sampling_rate<1>();
+	constexpr size_t decim_1_output_fs = decim_t::output_sampling_rate;
 
 	constexpr size_t demod_input_fs = decim_1_output_fs;
 
 	spectrum_interval_samples = decim_1_output_fs / spectrum_rate_hz;
 	spectrum_samples = 0;
 
-	decim_0.configure(message.decim_0_filter.taps, 33554432);
-	decim_1.configure(message.decim_1_filter.taps, 131072);
+	decim.stage<0>().configure(message.decim_0_filter.taps, 33554432);
+	decim.stage<1>().configure(message.decim_1_filter.taps, 131072);
 	channel_filter_pass_f = message.decim_1_filter.pass_frequency_normalized * decim_1_input_fs;
 	channel_filter_stop_f = message.decim_1_filter.stop_frequency_normalized * decim_1_input_fs;
 	demod.configure(demod_input_fs, message.deviation);
 	audio_filter.configure(message.audio_filter.taps);
-	audio_output.configure(message.audio_hpf_config, message.audio_deemph_config);
+	difference_filter.configure(message.audio_filter.taps);
+	audio_output.configure(message.audio_hpf_config, message.audio_deemph_config, message.squelch_level);
+
+	/* audio_dec_1 is [1 4 6 4 1]/16 at 384kHz, cos^4(pi*f/fs): 0.82 around
+	 * 38kHz where L-R sits, ~1.0 for L+R.
+	 */
+	constexpr size_t mpx_fs = demod_input_fs / 2;
+	stereo.configure(mpx_fs, 1.0f / 0.8217f);
+	rds_decoder.configure(mpx_fs / dsp::demodulate::FMStereo::rds_decimation, 1.0f / (32768.0f * 4096.0f));
+	status_interval_samples = mpx_fs / status_rate_hz;
+	status_samples = 0;
 
 	channel_spectrum.set_decimation_factor(1);
 
@@ -149,6 +174,16 @@ void WidebandFMAudio::pwmrssi_config(const PWMRSSIConfigureMessage& message) {
 	synth_acc = 0;
 }
 
+void WidebandFMAudio::send_status(const size_t sample_count) {
+	status_samples += sample_count;
+	if( status_samples >= status_interval_samples ) {
+		status_samples -= status_interval_samples;
+
+		const WFMStatusMessage message { stereo.stereo(), rds_decoder.program() };
+		shared_memory.application_queue.push(message);
+	}
+}
+
 void WidebandFMAudio::capture_config(const CaptureConfigMessage& message) {
 	if( message.config ) {
 		audio_output.set_stream(std::make_unique<StreamInput>(message.config));
@@ -27,8 +27,13 @@
 #include "baseband_thread.hpp"
 #include "rssi_thread.hpp"
 
+#include "baseband_dma.hpp"
+
 #include "dsp_decimate.hpp"
+#include "dsp_pipeline.hpp"
 #include "dsp_demodulate.hpp"
+#include "fm_stereo.hpp"
+#include "rds_decoder.hpp"
 
 #include "audio_output.hpp"
 #include "spectrum_collector.hpp"
@@ -42,19 +47,19 @@ public:
 private:
 	static constexpr size_t baseband_fs = 3072000;
 	static constexpr auto spectrum_rate_hz = 50.0f;
+	static constexpr size_t status_rate_hz = 4;
 
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20, baseband::Direction::Receive };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
-	std::array<complex16_t, 512> dst { };
-	const buffer_c16_t dst_buffer {
-		dst.data(),
-		dst.size()
-	};
-	const buffer_s16_t work_audio_buffer {
-		(int16_t*)dst.data(),
-		sizeof(dst) / sizeof(int16_t)
-	};
+	using decim_t = dsp::pipeline::Pipeline<
+		baseband_fs, baseband::dma::transfer_samples,
+		dsp::decimate::FIRC8xR16x24FS4Decim4,
+		dsp::decimate::FIRC16xR16x16Decim2
+	>;
+
+	decim_t decim { };
+	const buffer_s16_t work_audio_buffer { decim.scratch<int16_t>() };
 	
 	std::array<int16_t, 32> pwm { };
 	const buffer_s16_t pwmrssi_audio_buffer {
@@ -62,8 +67,6 @@ private:
 		sizeof(pwm) / sizeof(int16_t)
 	};
 
-	dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0 { };
-	dsp::decimate::FIRC16xR16x16Decim2 decim_1 { };
 	uint32_t channel_filter_pass_f = 0;
 	uint32_t channel_filter_stop_f = 0;
 
@@ -72,6 +75,27 @@ private:
 	dsp::decimate::DecimateBy2CIC4Real audio_dec_2 { };
 	dsp::decimate::FIR64AndDecimateBy2Real audio_filter { };
 
+	/* Stereo and RDS share the 192kHz multiplex from audio_dec_1. L-R follows
+	 * the same decimation and filter as L+R.
+	 */
+	dsp::demodulate::FMStereo stereo { };
+	std::array<int16_t, 128> difference { };
+	const buffer_s16_t difference_buffer {
+		difference.data(),
+		difference.size()
+	};
+	dsp::decimate::DecimateBy2CIC4Real difference_dec { };
+	dsp::decimate::FIR64AndDecimateBy2Real difference_filter { };
+
+	std::array<complex32_t, 128 / dsp::demodulate::FMStereo::rds_decimation> rds_samples { };
+	const buffer_c32_t rds_buffer {
+		rds_samples.data(),
+		rds_samples.size()
+	};
+	rds::RDSDecoder rds_decoder { };
+	size_t status_interval_samples { 0 };
+	size_t status_samples { 0 };
+
 	AudioOutput audio_output { };
 
 	SpectrumCollector channel_spectrum { };
@@ -87,6 +111,7 @@ private:
 	void pwmrssi_config(const PWMRSSIConfigureMessage& message);
 	void configure(const WFMConfigureMessage& message);
 	void capture_config(const CaptureConfigMessage& message);
+	void send_status(const size_t sample_count);
 };
 
 #endif/*__PROC_WFM_AUDIO_H__*/
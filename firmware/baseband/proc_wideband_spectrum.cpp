@@ -29,6 +29,7 @@
 #include <cstddef>
 
 #include <array>
+#include <cmath>
 
 void WidebandSpectrum::execute(const buffer_c8_t& buffer) {
 	// 2048 complex8_t samples per buffer.
@@ -47,7 +48,19 @@ void WidebandSpectrum::execute(const buffer_c8_t& buffer) {
 		spectrum[i] += buffer.p[i + 1024];
 	}
 
+	iq_correction.update(buffer);
+
 	if( phase == trigger ) {
+		// Remove the receiver's DC offset, summed over every sample in each bin.
+		const int32_t n = (trigger + 1) * 2;
+		const complex16_t dc_removal {
+			static_cast<int16_t>(-std::lround(iq_correction.dc_i() * n)),
+			static_cast<int16_t>(-std::lround(iq_correction.dc_q() * n))
+		};
+		for(auto& bin : spectrum) {
+			bin += dc_removal;
+		}
+
 		const buffer_c16_t buffer_c16 {
 			spectrum.data(),
 			spectrum.size(),
@@ -28,6 +28,8 @@
 
 #include "spectrum_collector.hpp"
 
+#include "dsp_iq_correction.hpp"
+
 #include "message.hpp"
 
 #include <cstddef>
@@ -45,6 +47,8 @@ private:
 	
 	size_t baseband_fs = 20000000;
 
+	dsp::iq_correction::IQCorrection iq_correction { };
+
 	BasebandThread baseband_thread { baseband_fs, this, NORMALPRIO + 20 };
 	RSSIThread rssi_thread { NORMALPRIO + 10 };
 
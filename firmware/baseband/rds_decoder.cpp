@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "rds_decoder.hpp"
+
+#include "sine_table.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+namespace rds {
+
+namespace {
+
+constexpr float phase_per_radian { 4294967296.0f / (2.0f * pi) };
+
+/* Offset words A, B, C, C', D and the group block each one marks. */
+constexpr std::array<uint16_t, 5> offset_words { { 0x0fc, 0x198, 0x168, 0x350, 0x1b4 } };
+constexpr std::array<size_t, 5> offset_block_index { { 0, 1, 2, 2, 3 } };
+
+/* data * x^10 mod g(x), g(x) = x^10 + x^8 + x^7 + x^5 + x^4 + x^3 + 1 */
+uint16_t checkword(const uint16_t data) {
+	uint32_t reg = 0;
+	for(int i=15; i>=0; i--) {
+		const bool feedback = ((reg >> 9) ^ (data >> i)) & 1;
+		reg = (reg << 1) & 0x3ff;
+		if( feedback ) {
+			reg ^= 0x1b9;
+		}
+	}
+	return reg;
+}
+
+/* Index into offset_words of a 26-bit block, -1 if the check word is bad. */
+int block_offset(const uint32_t block) {
+	const uint16_t syndrome = checkword(block >> 10) ^ (block & 0x3ff);
+	for(size_t i=0; i<offset_words.size(); i++) {
+		if( syndrome == offset_words[i] ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+char printable(const uint8_t c) {
+	return ((c >= 0x20) && (c < 0x7f)) ? c : ' ';
+}
+
+} /* namespace */
+
+void RDSDecoder::configure(const float sampling_rate, const float input_scale) {
+	constexpr float cutoff { 2400.0f };
+	constexpr float damping { 0.707f };
+	constexpr float natural_frequency { 2.0f * pi * 20.0f };
+
+	const IIRBiquadCascade<2>::config_t lowpass_config { {
+		iir_biquad_lowpass(cutoff, sampling_rate, 0.54119610f),
+		iir_biquad_lowpass(cutoff, sampling_rate, 1.30656296f),
+	} };
+	lowpass_i.configure(lowpass_config);
+	lowpass_q.configure(lowpass_config);
+	lowpass_i.reset();
+	lowpass_q.reset();
+	input_scale_ = input_scale;
+
+	carrier_phase = 0;
+	carrier_frequency = 0;
+	kp = 2.0f * damping * natural_frequency / sampling_rate * phase_per_radian;
+	ki = natural_frequency * natural_frequency / (sampling_rate * sampling_rate) * phase_per_radian;
+	magnitude = 0;
+
+	clock_recovery.configure(sampling_rate, symbol_rate, { 1.0f / 16.0f });
+
+	reset();
+}
+
+void RDSDecoder::reset() {
+	symbol_last = 0;
+	symbol_parity = 0;
+	pairing_metric = { };
+	bit_last = false;
+
+	block_shift = 0;
+	bit_count = 0;
+	sync_bit_count = 0;
+	sync_offset = -1;
+	synced = false;
+	block_index = 0;
+	bad_blocks = 0;
+	group_valid = { };
+	radiotext_ab = 0xff;
+
+	program_ = { };
+	program_.ps.fill(' ');
+	program_.radiotext.fill(' ');
+}
+
+void RDSDecoder::execute(const buffer_c32_t& baseband) {
+	constexpr float magnitude_alpha { 1.0f / 256.0f };
+
+	for(size_t offset=0; offset<baseband.count; offset+=work_i.size()) {
+		const size_t count = std::min(baseband.count - offset, work_i.size());
+		for(size_t n=0; n<count; n++) {
+			work_i[n] = baseband.p[offset + n].real() * input_scale_;
+			work_q[n] = baseband.p[offset + n].imag() * input_scale_;
+		}
+		lowpass_i.execute_in_place({ work_i.data(), count });
+		lowpass_q.execute_in_place({ work_q.data(), count });
+
+		for(size_t n=0; n<count; n++) {
+			// Costas loop, BPSK: the 180 degree ambiguity goes away in differential decoding.
+			const float s = sin_f32_phase(carrier_phase);
+			const float c = sin_f32_phase(carrier_phase + 0x40000000U);
+			const float re = work_i[n] * c + work_q[n] * s;
+			const float im = work_q[n] * c - work_i[n] * s;
+
+			magnitude += (std::abs(re) + std::abs(im) - magnitude) * magnitude_alpha;
+			const float magnitude_inv = 1.0f / std::max(magnitude, 1.0e-6f);
+			const float error = std::min(std::max(((re >= 0.0f) ? im : -im) * magnitude_inv, -1.0f), 1.0f);
+
+			carrier_frequency += ki * error;
+			carrier_phase += static_cast<int32_t>(carrier_frequency + kp * error);
+
+			clock_recovery(re * magnitude_inv,
+				[this](const float symbol) {
+					this->on_symbol(symbol);
+				}
+			);
+		}
+	}
+
+	program_.synced = synced;
+}
+
+/* Each bit is two symbols of opposite sign. Pairs straddling a bit boundary
+ * differ less on average, which picks the pairing.
+ */
+void RDSDecoder::on_symbol(const float symbol) {
+	constexpr float metric_alpha { 1.0f / 32.0f };
+
+	symbol_parity ^= 1;
+	auto& metric = pairing_metric[symbol_parity];
+	metric += (std::abs(symbol_last - symbol) - metric) * metric_alpha;
+
+	if( metric > pairing_metric[symbol_parity ^ 1] ) {
+		const bool bit = (symbol_last > symbol);
+		on_bit(bit != bit_last);
+		bit_last = bit;
+	}
+
+	symbol_last = symbol;
+}
+
+void RDSDecoder::on_bit(const bool bit) {
+	block_shift = ((block_shift << 1) | (bit ? 1 : 0)) & ((1U << block_bits) - 1);
+	bit_count++;
+
+	if( !synced ) {
+		/* Two good blocks, one block apart and in sequence. */
+		const int offset = block_offset(block_shift);
+		if( offset < 0 ) {
+			return;
+		}
+		if( (sync_offset >= 0) &&
+			((bit_count - sync_bit_count) == block_bits) &&
+			(offset_block_index[offset] == ((offset_block_index[sync_offset] + 1) & 3))
+		) {
+			synced = true;
+			bad_blocks = 0;
+			group_valid = { };
+			block_index = offset_block_index[offset];
+			on_block(offset, block_shift >> 10);
+		}
+		sync_offset = offset;
+		sync_bit_count = bit_count;
+		return;
+	}
+
+	if( (bit_count - sync_bit_count) < block_bits ) {
+		return;
+	}
+	sync_bit_count = bit_count;
+	block_index = (block_index + 1) & 3;
+
+	const int offset = block_offset(block_shift);
+	if( (offset >= 0) && (offset_block_index[offset] == block_index) ) {
+		bad_blocks = 0;
+		on_block(offset, block_shift >> 10);
+	} else {
+		program_.block_errors++;
+		on_block(-1, 0);
+		if( ++bad_blocks > bad_blocks_max ) {
+			synced = false;
+			sync_offset = -1;
+		}
+	}
+}
+
+void RDSDecoder::on_block(const int offset, const uint16_t data) {
+	group[block_index] = data;
+	group_valid[block_index] = (offset >= 0);
+
+	if( block_index == 3 ) {
+		on_group();
+		group_valid = { };
+	}
+}
+
+void RDSDecoder::on_group() {
+	if( !group_valid[1] ) {
+		return;
+	}
+
+	const uint16_t b = group[1];
+	const uint16_t c = group[2];
+	const uint16_t d = group[3];
+	const size_t group_type = b >> 12;
+	const bool version_b = (b >> 11) & 1;
+
+	if( group_valid[0] ) {
+		program_.pi = group[0];
+	}
+	program_.program_type = (b >> 5) & 0x1f;
+	program_.groups++;
+
+	if( (group_type == 0) && group_valid[3] ) {
+		// Program service name, two characters per group.
+		const size_t address = (b & 0x3) * 2;
+		program_.ps[address + 0] = printable(d >> 8);
+		program_.ps[address + 1] = printable(d & 0xff);
+	}
+
+	if( group_type == 2 ) {
+		// RadioText: 2A carries four characters in C and D, 2B two in D.
+		const uint8_t ab = (b >> 4) & 1;
+		if( ab != radiotext_ab ) {
+			radiotext_ab = ab;
+			program_.radiotext.fill(' ');
+			program_.radiotext_length = 0;
+		}
+
+		std::array<uint8_t, 4> chars { };
+		size_t count = 0;
+		if( !version_b && group_valid[2] && group_valid[3] ) {
+			chars = { { static_cast<uint8_t>(c >> 8), static_cast<uint8_t>(c & 0xff), static_cast<uint8_t>(d >> 8), static_cast<uint8_t>(d & 0xff) } };
+			count = 4;
+		} else if( version_b && group_valid[3] ) {
+			chars = { { static_cast<uint8_t>(d >> 8), static_cast<uint8_t>(d & 0xff), 0, 0 } };
+			count = 2;
+		}
+
+		const size_t address = (b & 0xf) * count;
+		for(size_t i=0; i<count; i++) {
+			if( chars[i] == 0x0d ) {
+				// Carriage return ends the text early.
+				program_.radiotext_length = address + i;
+				break;
+			}
+			program_.radiotext[address + i] = printable(chars[i]);
+			program_.radiotext_length = std::max(program_.radiotext_length, address + i + 1);
+		}
+	}
+}
+
+} /* namespace rds */
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __RDS_DECODER_H__
+#define __RDS_DECODER_H__
+
+#include "dsp_types.hpp"
+#include "dsp_iir.hpp"
+#include "clock_recovery.hpp"
+#include "message.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+namespace rds {
+
+/* Receives RDS from the complex 57kHz baseband produced by FMStereo.
+ *
+ * Low-pass, Costas loop for the (pilot-locked, but 0 or 90 degree) carrier
+ * phase, clock recovery at the 2375 baud biphase symbol rate, Manchester and
+ * differential decoding, then block sync on the 26-bit block syndromes. Groups
+ * 0A/0B (PS) and 2A/2B (RadioText) fill in RDSProgram. No error correction,
+ * blocks with a bad check word are dropped.
+ */
+class RDSDecoder {
+public:
+	void configure(const float sampling_rate, const float input_scale);
+
+	void execute(const buffer_c32_t& baseband);
+
+	const RDSProgram& program() const {
+		return program_;
+	}
+
+private:
+	static constexpr float symbol_rate { 2375.0f };
+	static constexpr size_t block_bits { 26 };
+	static constexpr size_t bad_blocks_max { 12 };
+
+	IIRBiquadCascade<2> lowpass_i { };
+	IIRBiquadCascade<2> lowpass_q { };
+	std::array<float, 16> work_i { };
+	std::array<float, 16> work_q { };
+	float input_scale_ { 1.0f };
+
+	uint32_t carrier_phase { 0 };
+	float carrier_frequency { 0 };
+	float kp { 0 };
+	float ki { 0 };
+	float magnitude { 0 };
+
+	clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery {
+		12000.0f, symbol_rate, { 1.0f / 16.0f }
+	};
+
+	float symbol_last { 0 };
+	size_t symbol_parity { 0 };
+	std::array<float, 2> pairing_metric { };
+	bool bit_last { false };
+
+	uint32_t block_shift { 0 };
+	uint32_t bit_count { 0 };
+	uint32_t sync_bit_count { 0 };
+	int sync_offset { -1 };
+	bool synced { false };
+	size_t block_index { 0 };
+	size_t bad_blocks { 0 };
+	std::array<uint16_t, 4> group { };
+	std::array<bool, 4> group_valid { };
+	uint8_t radiotext_ab { 0xff };
+
+	RDSProgram program_ { };
+
+	void reset();
+	void on_symbol(const float symbol);
+	void on_bit(const bool bit);
+	void on_block(const int offset, const uint16_t data);
+	void on_group();
+};
+
+} /* namespace rds */
+
+#endif/*__RDS_DECODER_H__*/
@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "subtone_detector.hpp"
+
+#include "sine_table.hpp"
+
+#include <algorithm>
+
+namespace {
+
+constexpr uint32_t dcs_word_mask { (1U << 23) - 1 };
+constexpr uint32_t dcs_golay_generator { 0xc75 };
+
+/* Golay(23,12) parity of the twelve data bits. */
+uint32_t dcs_parity(const uint32_t data) {
+	uint32_t r = data << 11;
+	for(size_t i=22; i>=11; i--) {
+		if( r & (1U << i) ) {
+			r ^= dcs_golay_generator << (i - 11);
+		}
+	}
+	return r & 0x7ff;
+}
+
+/* Code words go out LSB first: nine code bits, the "100" marker, then eleven
+ * parity bits. Returns true and the nine-bit code if word is a DCS code word.
+ */
+bool dcs_decode(const uint32_t word, uint16_t& code) {
+	const uint32_t data = word & 0xfff;
+	if( (data >> 9) != 0b100 ) {
+		return false;
+	}
+	if( (word >> 12) != dcs_parity(data) ) {
+		return false;
+	}
+	code = data & 0x1ff;
+	return true;
+}
+
+} /* namespace */
+
+void SubtoneDetector::configure(const uint32_t sampling_rate_in) {
+	decimation_factor = std::max<uint32_t>(1, (sampling_rate_in + decimated_rate_target / 2) / decimated_rate_target);
+	decimation_phase = 0;
+	sampling_rate = static_cast<float>(sampling_rate_in) / decimation_factor;
+
+	// Fourth-order Butterworth.
+	lowpass.configure({ {
+		iir_biquad_lowpass(lowpass_cutoff, sampling_rate_in, 0.54119610f),
+		iir_biquad_lowpass(lowpass_cutoff, sampling_rate_in, 1.30656296f),
+	} });
+	lowpass.reset();
+
+	dc_x1 = 0;
+	dc_y1 = 0;
+
+	for(size_t i=0; i<tones.size(); i++) {
+		const float w = 2.0f * pi * ctcss_tones[i].frequency / sampling_rate;
+		tones[i] = { 2.0f * sin_f32(w + pi * 0.5f), 0, 0 };
+	}
+	block_energy = 0;
+	block_samples = 0;
+	block_length = sampling_rate * block_duration;
+	ctcss_detected = { };
+	ctcss_misses = 0;
+
+	dcs_bit_step = dcs_bit_rate / sampling_rate;
+	dcs_bit_phase = 0;
+	dcs_shift = 0;
+	dcs_bit_count = 0;
+	dcs_candidate_bit_count = 0;
+	dcs_candidate = { };
+	dcs_candidate_matches = 0;
+	dcs_detected = { };
+	dcs_hold = 0;
+
+	detected = { };
+}
+
+bool SubtoneDetector::feed(const buffer_f32_t& audio) {
+	bool block_complete = false;
+
+	for(size_t offset=0; offset<audio.count; offset+=lowpass_out.size()) {
+		const size_t count = std::min(audio.count - offset, lowpass_out.size());
+		const buffer_f32_t src { &audio.p[offset], count, audio.sampling_rate };
+		const buffer_f32_t dst { lowpass_out.data(), count, audio.sampling_rate };
+		lowpass.execute(src, dst);
+
+		for(size_t i=0; i<count; i++) {
+			if( ++decimation_phase >= decimation_factor ) {
+				decimation_phase = 0;
+				block_complete |= execute(dst.p[i]);
+			}
+		}
+	}
+
+	return block_complete;
+}
+
+bool SubtoneDetector::execute(const float sample) {
+	// Demodulator DC (carrier offset) would bias the DCS slicer.
+	const float v = sample - dc_x1 + 0.995f * dc_y1;
+	dc_x1 = sample;
+	dc_y1 = v;
+
+	for(auto& tone : tones) {
+		const float s0 = v + tone.coefficient * tone.s1 - tone.s2;
+		tone.s2 = tone.s1;
+		tone.s1 = s0;
+	}
+	block_energy += v * v;
+
+	execute_dcs(v);
+
+	if( ++block_samples < block_length ) {
+		return false;
+	}
+
+	update_ctcss(ctcss_block_result());
+	if( dcs_hold ) {
+		dcs_hold--;
+		detected = dcs_detected;
+	} else {
+		detected = ctcss_detected;
+	}
+
+	return true;
+}
+
+Subtone SubtoneDetector::ctcss_block_result() {
+	size_t best_index = 0;
+	float best_power = 0;
+	for(size_t i=0; i<tones.size(); i++) {
+		const auto& tone = tones[i];
+		const float power = tone.s1 * tone.s1 + tone.s2 * tone.s2 - tone.coefficient * tone.s1 * tone.s2;
+		if( power > best_power ) {
+			best_power = power;
+			best_index = i;
+		}
+	}
+
+	/* A pure tone puts half of N*energy into its bin, so ratio is ~1.0 for a
+	 * clean tone and falls with noise and voice leaking into the band.
+	 */
+	const float n = block_samples;
+	const float ratio = (block_energy > 0) ? (2.0f * best_power / (n * block_energy)) : 0.0f;
+	const bool present = (block_energy >= (ctcss_power_min * n)) && (ratio >= ctcss_ratio_min);
+
+	for(auto& tone : tones) {
+		tone.s1 = 0;
+		tone.s2 = 0;
+	}
+	block_energy = 0;
+	block_samples = 0;
+
+	return present ? Subtone { Subtone::Type::CTCSS, static_cast<uint16_t>(best_index) } : Subtone { };
+}
+
+/* A hit (re)opens at once, misses only count against the tone being held. */
+void SubtoneDetector::update_ctcss(const Subtone& ctcss) {
+	if( ctcss.type != Subtone::Type::None ) {
+		ctcss_detected = ctcss;
+		ctcss_misses = 0;
+	} else if( ctcss_detected.type != Subtone::Type::None ) {
+		if( ++ctcss_misses >= ctcss_hold_blocks ) {
+			ctcss_detected = { };
+			ctcss_misses = 0;
+		}
+	}
+}
+
+void SubtoneDetector::execute_dcs(const float sample) {
+	const bool level = (sample > 0);
+	if( level != dcs_last_level ) {
+		// Pull the bit clock so that transitions land on phase 0.
+		const float error = (dcs_bit_phase < 0.5f) ? dcs_bit_phase : (dcs_bit_phase - 1.0f);
+		dcs_bit_phase -= error * dcs_pll_gain;
+		dcs_last_level = level;
+	}
+
+	const float phase_prev = dcs_bit_phase;
+	dcs_bit_phase += dcs_bit_step;
+	if( dcs_bit_phase >= 1.0f ) {
+		dcs_bit_phase -= 1.0f;
+	}
+	if( (phase_prev >= 0.5f) || (dcs_bit_phase < 0.5f) ) {
+		return;
+	}
+
+	// Mid-bit: shift in the new bit, oldest bit ends up in bit 0.
+	dcs_shift = ((dcs_shift >> 1) | (level ? (1U << 22) : 0)) & dcs_word_mask;
+	dcs_bit_count++;
+
+	uint16_t code;
+	Subtone match { };
+	if( dcs_decode(dcs_shift, code) ) {
+		match = { Subtone::Type::DCS, code, false };
+	} else if( dcs_decode(~dcs_shift & dcs_word_mask, code) ) {
+		match = { Subtone::Type::DCS, code, true };
+	} else {
+		return;
+	}
+
+	/* A code word repeats every 23 bits. Rotations of it may also decode (DCS
+	 * "aliases"), so hold on to the first candidate until it goes stale.
+	 */
+	const uint32_t bits_since = dcs_bit_count - dcs_candidate_bit_count;
+	if( (match == dcs_candidate) && (bits_since == 23) ) {
+		dcs_candidate_matches++;
+	} else if( (dcs_candidate_matches == 0) || (bits_since > 23) ) {
+		dcs_candidate = match;
+		dcs_candidate_matches = 1;
+	} else {
+		return;
+	}
+	dcs_candidate_bit_count = dcs_bit_count;
+
+	if( dcs_candidate_matches >= 2 ) {
+		dcs_detected = dcs_candidate;
+		dcs_hold = dcs_hold_blocks;
+	}
+}
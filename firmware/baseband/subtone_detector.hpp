@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SUBTONE_DETECTOR_H__
+#define __SUBTONE_DETECTOR_H__
+
+#include "dsp_types.hpp"
+#include "dsp_iir.hpp"
+#include "message.hpp"
+#include "ctcss.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+/* CTCSS and DCS detection on demodulated FM audio, taken before the audio
+ * high-pass filter removes the sub-audible band.
+ *
+ * Audio is low-passed to ~280Hz and decimated to ~750Hz. CTCSS runs a
+ * Goertzel filter per tone over 0.4s blocks, resolving the 2.5Hz tone
+ * spacing. DCS slices the same stream at 134.4bps and checks each 23-bit
+ * window for a Golay(23,12) code word carrying the "100" marker.
+ */
+class SubtoneDetector {
+public:
+	void configure(const uint32_t sampling_rate);
+
+	template<typename Callback>
+	void feed(const buffer_f32_t& audio, Callback callback) {
+		if( feed(audio) ) {
+			callback(detected);
+		}
+	}
+
+private:
+	static constexpr uint32_t decimated_rate_target { 750 };
+	static constexpr float lowpass_cutoff { 280.0f };
+	static constexpr float block_duration { 0.4f };
+	static constexpr float ctcss_ratio_min { 0.5f };
+	static constexpr float ctcss_power_min { 0.02f * 0.02f };
+	/* Voice can swamp the tone for a block, drop it after this many misses in a row. */
+	static constexpr uint32_t ctcss_hold_blocks { 2 };
+
+	static constexpr float dcs_bit_rate { 134.4f };
+	static constexpr float dcs_pll_gain { 0.25f };
+	static constexpr uint32_t dcs_hold_blocks { 2 };
+
+	IIRBiquadCascade<2> lowpass { };
+	std::array<float, 32> lowpass_out { };
+	size_t decimation_factor { 1 };
+	size_t decimation_phase { 0 };
+	float sampling_rate { 0 };
+
+	float dc_x1 { 0 };
+	float dc_y1 { 0 };
+
+	struct goertzel_t {
+		float coefficient;
+		float s1;
+		float s2;
+	};
+	std::array<goertzel_t, CTCSS_TONES_NB> tones { };
+	float block_energy { 0 };
+	size_t block_samples { 0 };
+	size_t block_length { 0 };
+	Subtone ctcss_detected { };
+	uint32_t ctcss_misses { 0 };
+
+	float dcs_bit_step { 0 };
+	float dcs_bit_phase { 0 };
+	bool dcs_last_level { false };
+	uint32_t dcs_shift { 0 };
+	uint32_t dcs_bit_count { 0 };
+	uint32_t dcs_candidate_bit_count { 0 };
+	Subtone dcs_candidate { };
+	uint32_t dcs_candidate_matches { 0 };
+	Subtone dcs_detected { };
+	uint32_t dcs_hold { 0 };
+
+	Subtone detected { };
+
+	bool feed(const buffer_f32_t& audio);
+	bool execute(const float sample);
+	void execute_dcs(const float sample);
+	Subtone ctcss_block_result();
+	void update_ctcss(const Subtone& ctcss);
+};
+
+#endif/*__SUBTONE_DETECTOR_H__*/
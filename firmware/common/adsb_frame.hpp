@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2017 Furrtek
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __ADSB_FRAME_H__
+#define __ADSB_FRAME_H__
+
+#include <cstdint>
+#include <cstddef>
+
+#include "baseband.hpp"
+#include "crc.hpp"
+
+namespace adsb {
+
+constexpr size_t long_frame_length = 14;	// 112 bits
+constexpr size_t short_frame_length = 7;	// 56 bits
+
+/* Mode S parity: CRC-24 over everything but the last 24 bits, XORed with
+ * them. Zero for an intact frame whose parity field isn't overlaid with an
+ * address.
+ */
+inline uint32_t crc_syndrome(const uint8_t* const data, const size_t length) {
+	CRCTable<24, 0xfff409> crc { };
+	crc.process_bytes(data, length - 3);
+
+	const uint32_t parity = (data[length - 3] << 16) | (data[length - 2] << 8) | data[length - 1];
+	return crc.checksum() ^ parity;
+}
+
+class ADSBFrame {
+public:
+	uint8_t get_DF() const {
+		return raw_data[0] >> 3;
+	}
+
+	uint8_t get_TC() const {
+		return raw_data[4] >> 3;
+	}
+
+	uint32_t get_ICAO_address() const {
+		return (raw_data[1] << 16) | (raw_data[2] << 8) | raw_data[3];
+	}
+
+	size_t length() const {
+		return (get_DF() & 0x10) ? long_frame_length : short_frame_length;
+	}
+
+	uint32_t syndrome() const {
+		return crc_syndrome(raw_data, length());
+	}
+
+	const uint8_t* get_raw_data() const {
+		return raw_data;
+	}
+
+	void set_byte(const size_t index, const uint8_t value) {
+		if( index < long_frame_length ) {
+			raw_data[index] = value;
+		}
+	}
+
+	void flip_bit(const size_t bit) {
+		if( bit < (long_frame_length * 8) ) {
+			raw_data[bit >> 3] ^= 0x80 >> (bit & 7);
+		}
+	}
+
+	void set_rx_timestamp(const Timestamp& value) {
+		rx_timestamp = value;
+	}
+
+	Timestamp get_rx_timestamp() const {
+		return rx_timestamp;
+	}
+
+	void clear() {
+		for(auto& b : raw_data) {
+			b = 0;
+		}
+	}
+
+private:
+	uint8_t raw_data[long_frame_length] { };
+	Timestamp rx_timestamp { };
+};
+
+} /* namespace adsb */
+
+#endif/*__ADSB_FRAME_H__*/
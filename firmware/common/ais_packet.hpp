@@ -31,6 +31,12 @@
 
 namespace ais {
 
+/* Both AIS channels are received at once, 25kHz either side of 162.000MHz. */
+enum Channel : uint32_t {
+	A_87B = 0,	// 161.975MHz
+	B_88B = 1,	// 162.025MHz
+};
+
 struct DateTime {
 	uint16_t year;
 	uint8_t month;
@@ -98,12 +104,16 @@ using MMSI = uint32_t;
 class Packet {
 public:
 	constexpr Packet(
-		const baseband::Packet& packet
+		const baseband::Packet& packet,
+		const Channel channel
 	) : packet_ { packet },
+		channel_ { channel },
 		field_ { packet_ }
 	{
 	}
 
+	Channel channel() const { return channel_; }
+
 	size_t length() const;
 	
 	bool is_valid() const;
@@ -130,6 +140,7 @@ private:
 	using CRCReader = FieldReader<baseband::Packet, BitRemapNone>;
 	
 	const baseband::Packet packet_;
+	const Channel channel_;
 	const Reader field_;
 
 	const size_t fcs_length = 16;
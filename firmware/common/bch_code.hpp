@@ -2,7 +2,7 @@
  * Copyright (C) 2015 Craig Shelley (craig@microtron.org.uk)
  * Copyright (C) 2016 Furrtek
  *
- * BCH Encoder/Decoder - Adapted from GNURadio
+ * POCSAG BCH(31,21) + even parity codec
  * 
  * This file is part of PortaPack.
  *
@@ -25,37 +25,25 @@
 #ifndef __BCHCODE_H__
 #define __BCHCODE_H__
 
-#include <vector>
+#include <cstdint>
 
+/* POCSAG codewords, MSB first: 21 data bits (31..11), 10 BCH check bits
+ * (10..1), even parity (0). Generator x^10+x^9+x^8+x^6+x^5+x^3+1.
+ *
+ * Correction looks the syndrome up in a 1024-entry table, generated at
+ * compile time, of every 1- and 2-bit error pattern.
+ */
 class BCHCode {
 public:
-	BCHCode(std::vector<int> p_init, int m, int n, int k, int t);
-	~BCHCode();
-	
-	BCHCode(const BCHCode&) = delete;
-	BCHCode(BCHCode&&) = delete;
-	BCHCode& operator=(const BCHCode&) = delete;
-	BCHCode& operator=(BCHCode&&) = delete;
+	/* Replaces check and parity bits, computed from the data bits. */
+	static uint32_t encode(const uint32_t codeword);
 
-	int * encode(int data[]);
-	int decode(int recd[]);
-	
-private:
-	void gen_poly();
-	void generate_gf();
-	
-	bool valid { false };
+	/* Corrects codeword in place. Returns the number of bit errors fixed
+	 * (parity bit included), or -1 if the codeword is uncorrectable (it is
+	 * then left unchanged). */
+	static int correct(uint32_t& codeword);
 
-	int d { };
-	int * p { };			// coefficients of primitive polynomial used to generate GF(2**5)
-	int m { };				// order of the field GF(2**5) = 5
-	int n { };				// 2**5 - 1 = 31
-	int k { };				// n - deg(g(x)) = 21 = dimension
-	int t { };				// 2 = error correcting capability
-	int * alpha_to { };		// log table of GF(2**5)
-	int * index_of { };		// antilog table of GF(2**5)
-	int * g { };			// coefficients of generator polynomial, g(x) [n - k + 1]=[11]
-	int * bb { };			// coefficients of redundancy polynomial ( x**(10) i(x) ) modulo g(x)
+	static uint32_t syndrome(const uint32_t codeword);
 };
 
 #endif/*__BCHCODE_H__*/
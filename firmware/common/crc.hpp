@@ -153,6 +153,180 @@ private:
 	}
 };
 
+namespace crc_detail {
+
+template<size_t Slices>
+struct Table {
+	uint32_t v[Slices][256];
+};
+
+constexpr uint32_t mask(const size_t width) {
+	return (width == 32) ? 0xffffffffU : ((1U << width) - 1);
+}
+
+constexpr uint32_t reflect(uint32_t x, const size_t bits) {
+	uint32_t reflection = 0;
+	for(size_t i=0; i<bits; ++i) {
+		reflection = (reflection << 1) | (x & 1);
+		x >>= 1;
+	}
+	return reflection;
+}
+
+/* Reflected CRCs keep the remainder reflected in the low bits. The others
+ * keep it left-aligned in 32 bits, so one table shape serves every width. */
+constexpr uint32_t to_register(const uint32_t value, const size_t width, const bool reflected) {
+	return reflected ? reflect(value & mask(width), width) : ((value & mask(width)) << (32 - width));
+}
+
+constexpr uint32_t byte_remainder(const uint32_t index, const bool reflected, const uint32_t poly) {
+	uint32_t r = reflected ? index : (index << 24);
+	for(size_t i=0; i<8; i++) {
+		if( reflected ) {
+			r = (r & 1) ? ((r >> 1) ^ poly) : (r >> 1);
+		} else {
+			r = (r & 0x80000000U) ? ((r << 1) ^ poly) : (r << 1);
+		}
+	}
+	return r;
+}
+
+/* poly is in register form: reflected, or left-aligned in 32 bits. */
+template<size_t Slices>
+constexpr Table<Slices> make_table(const bool reflected, const uint32_t poly) {
+	Table<Slices> t { };
+	for(size_t i=0; i<256; i++) {
+		t.v[0][i] = byte_remainder(i, reflected, poly);
+	}
+	for(size_t s=1; s<Slices; s++) {
+		for(size_t i=0; i<256; i++) {
+			const auto prev = t.v[s - 1][i];
+			t.v[s][i] = reflected
+				? ((prev >> 8) ^ t.v[0][prev & 0xff])
+				: ((prev << 8) ^ t.v[0][prev >> 24]);
+		}
+	}
+	return t;
+}
+
+} /* namespace crc_detail */
+
+/* Table-driven CRC with the same interface as CRC<>, for a polynomial known
+ * at compile time. Lookup tables are generated at compile time and live in
+ * flash: 1KB for Slices=1 (byte at a time), 4KB for Slices=4 (slice-by-4,
+ * four bytes per step). Use CRC<> where flash is tighter than cycles.
+ */
+template<size_t Width, uint32_t TruncatedPolynomial, bool RevIn = false, bool RevOut = false, size_t Slices = 1>
+class CRCTable {
+	static_assert((Width > 0) && (Width <= 32), "CRC width must be 1...32 bits");
+	static_assert(RevIn == RevOut, "CRCTable requires RevIn == RevOut");
+	static_assert((Slices == 1) || (Slices == 4), "CRCTable supports 1 or 4 slices");
+
+public:
+	using value_type = uint32_t;
+
+	constexpr CRCTable(
+		const value_type initial_remainder = 0,
+		const value_type final_xor_value = 0
+	) : initial_remainder { initial_remainder },
+		final_xor_value { final_xor_value },
+		remainder { to_register(initial_remainder) }
+	{
+	}
+
+	value_type get_initial_remainder() const {
+		return initial_remainder;
+	}
+
+	void reset(value_type new_initial_remainder) {
+		remainder = to_register(new_initial_remainder);
+	}
+
+	void reset() {
+		remainder = to_register(initial_remainder);
+	}
+
+	void process_byte(const uint8_t byte) {
+		remainder = step(remainder, byte);
+	}
+
+	void process_bytes(const void* const data, const size_t length) {
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+		size_t n = length;
+		auto r = remainder;
+		if( Slices == 4 ) {
+			for(; n>=4; n-=4, p+=4) {
+				r = step4(r, p);
+			}
+		}
+		for(; n>0; n--, p++) {
+			r = step(r, *p);
+		}
+		remainder = r;
+	}
+
+	template<size_t N>
+	void process_bytes(const std::array<uint8_t, N>& data) {
+		process_bytes(data.data(), data.size());
+	}
+
+	value_type checksum() const {
+		/* Reflected register already holds the reflected remainder. */
+		const auto r = RevIn ? remainder : (remainder >> (32 - Width));
+		return (r ^ final_xor_value) & mask();
+	}
+
+private:
+	using Table = crc_detail::Table<Slices>;
+
+	static constexpr Table table = crc_detail::make_table<Slices>(RevIn, crc_detail::to_register(TruncatedPolynomial, Width, RevIn));
+
+	const value_type initial_remainder;
+	const value_type final_xor_value;
+
+	value_type remainder;
+
+	static constexpr value_type mask() {
+		return crc_detail::mask(Width);
+	}
+
+	static constexpr value_type to_register(const value_type value) {
+		return crc_detail::to_register(value, Width, RevIn);
+	}
+
+	static value_type step(const value_type r, const uint8_t byte) {
+		if( RevIn ) {
+			return (r >> 8) ^ table.v[0][(r ^ byte) & 0xff];
+		} else {
+			return (r << 8) ^ table.v[0][(r >> 24) ^ byte];
+		}
+	}
+
+	static value_type step4(value_type r, const uint8_t* const p) {
+		/* Slices is a template parameter, index with it so Slices=1 tables
+		 * are never read out of bounds. */
+		constexpr size_t s1 = (Slices > 1) ? 1 : 0;
+		constexpr size_t s2 = (Slices > 2) ? 2 : 0;
+		constexpr size_t s3 = (Slices > 3) ? 3 : 0;
+		if( RevIn ) {
+			r ^= (p[0] << 0) | (p[1] << 8) | (p[2] << 16) | (static_cast<value_type>(p[3]) << 24);
+			return table.v[s3][(r >>  0) & 0xff]
+			     ^ table.v[s2][(r >>  8) & 0xff]
+			     ^ table.v[s1][(r >> 16) & 0xff]
+			     ^ table.v[ 0][(r >> 24) & 0xff];
+		} else {
+			r ^= (static_cast<value_type>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | (p[3] << 0);
+			return table.v[s3][(r >> 24) & 0xff]
+			     ^ table.v[s2][(r >> 16) & 0xff]
+			     ^ table.v[s1][(r >>  8) & 0xff]
+			     ^ table.v[ 0][(r >>  0) & 0xff];
+		}
+	}
+};
+
+template<size_t Width, uint32_t TruncatedPolynomial, bool RevIn, bool RevOut, size_t Slices>
+constexpr typename CRCTable<Width, TruncatedPolynomial, RevIn, RevOut, Slices>::Table CRCTable<Width, TruncatedPolynomial, RevIn, RevOut, Slices>::table;
+
 class Adler32 {
 public:
 	void feed(const uint8_t v) {
@@ -160,9 +334,19 @@ public:
 	}
 
 	void feed(const void* const data, const size_t n) {
-		const uint8_t* const p = reinterpret_cast<const uint8_t*>(data);
-		for(size_t i=0; i<n; i++) {
-			feed_one(p[i]);
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+		size_t remaining = n;
+		while( remaining > 0 ) {
+			/* Defer the modulo for as long as b cannot overflow 32 bits. */
+			const size_t count = (remaining < nmax) ? remaining : nmax;
+			for(size_t i=0; i<count; i++) {
+				a += p[i];
+				b += a;
+			}
+			a %= mod;
+			b %= mod;
+			p += count;
+			remaining -= count;
 		}
 	}
 
@@ -182,6 +366,7 @@ public:
 
 private:
 	static constexpr uint32_t mod = 65521;
+	static constexpr size_t nmax = 5552;
 
 	uint32_t a { 1 };
 	uint32_t b { 0 };
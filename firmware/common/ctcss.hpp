@@ -23,7 +23,7 @@
 #ifndef __CTCSS_H_
 #define __CTCSS_H_
 
-#include "ui.hpp"
+#include <cstdint>
 
 #define CTCSS_TONES_NB 50
 
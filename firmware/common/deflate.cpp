@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "deflate.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+struct CodeBase {
+	uint16_t base;
+	uint8_t extra_bits;
+};
+
+/* RFC 1951 3.2.5, length codes 257...285 */
+constexpr std::array<CodeBase, 29> length_codes { {
+	{   3, 0 }, {   4, 0 }, {   5, 0 }, {   6, 0 }, {   7, 0 }, {   8, 0 }, {   9, 0 }, {  10, 0 },
+	{  11, 1 }, {  13, 1 }, {  15, 1 }, {  17, 1 }, {  19, 2 }, {  23, 2 }, {  27, 2 }, {  31, 2 },
+	{  35, 3 }, {  43, 3 }, {  51, 3 }, {  59, 3 }, {  67, 4 }, {  83, 4 }, {  99, 4 }, { 115, 4 },
+	{ 131, 5 }, { 163, 5 }, { 195, 5 }, { 227, 5 }, { 258, 0 },
+} };
+
+/* RFC 1951 3.2.5, distance codes 0...29 */
+constexpr std::array<CodeBase, 30> distance_codes { {
+	{     1,  0 }, {     2,  0 }, {     3,  0 }, {     4,  0 }, {     5,  1 }, {     7,  1 },
+	{     9,  2 }, {    13,  2 }, {    17,  3 }, {    25,  3 }, {    33,  4 }, {    49,  4 },
+	{    65,  5 }, {    97,  5 }, {   129,  6 }, {   193,  6 }, {   257,  7 }, {   385,  7 },
+	{   513,  8 }, {   769,  8 }, {  1025,  9 }, {  1537,  9 }, {  2049, 10 }, {  3073, 10 },
+	{  4097, 11 }, {  6145, 11 }, {  8193, 12 }, { 12289, 12 }, { 16385, 13 }, { 24577, 13 },
+} };
+
+template<size_t N>
+size_t find_code(const std::array<CodeBase, N>& codes, const size_t value) {
+	size_t code = N - 1;
+	while( codes[code].base > value ) {
+		code--;
+	}
+	return code;
+}
+
+} /* namespace */
+
+DeflateEncoder::DeflateEncoder(
+	OutputHandler output_handler
+) : output_handler { std::move(output_handler) }
+{
+	/* zlib header: CM=8 (deflate), CINFO=7 (32K window), FLEVEL=0, FCHECK */
+	write_byte(0x78);
+	write_byte(0x01);
+
+	/* BFINAL=1, BTYPE=01 (fixed Huffman codes) */
+	write_bits(1, 1);
+	write_bits(1, 2);
+}
+
+void DeflateEncoder::feed(const void* const data, const size_t length) {
+	const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+	size_t remaining = length;
+	while( remaining > 0 ) {
+		/* Keep at least max_distance bytes of history behind the new data. */
+		const auto n = std::min(remaining, max_distance);
+		compress(p, n);
+		p += n;
+		remaining -= n;
+	}
+}
+
+void DeflateEncoder::finish() {
+	write_symbol(256);
+	align_to_byte();
+
+	for(const auto b : adler_32.bytes()) {
+		write_byte(b);
+	}
+
+	flush_output();
+}
+
+void DeflateEncoder::compress(const uint8_t* const data, const size_t length) {
+	for(size_t i=0; i<length; i++) {
+		window[(position + i) & window_mask] = data[i];
+	}
+	adler_32.feed(data, length);
+
+	const uint32_t end = position + length;
+	while( position < end ) {
+		const size_t available = std::min<size_t>(end - position, max_match);
+
+		size_t best_length = 0;
+		uint32_t best_distance = 0;
+		if( available >= min_match ) {
+			const auto h = hash(position);
+			const std::array<uint32_t, 2> candidates { {
+				(position - head[h]) & 0xffff,
+				last_distance,
+			} };
+			head[h] = position;
+
+			for(const auto distance : candidates) {
+				if( (distance == 0) || (distance > max_distance) || (distance > position) ) {
+					continue;
+				}
+				const auto length = match_length(position - distance, available);
+				if( length > best_length ) {
+					best_length = length;
+					best_distance = distance;
+				}
+			}
+		}
+
+		if( best_length >= min_match ) {
+			write_match(best_length, best_distance);
+			last_distance = best_distance;
+
+			for(size_t i=1; i<best_length; i++) {
+				const uint32_t p = position + i;
+				if( (end - p) >= min_match ) {
+					head[hash(p)] = p;
+				}
+			}
+			position += best_length;
+		} else {
+			write_symbol(window[position & window_mask]);
+			position++;
+		}
+	}
+}
+
+uint32_t DeflateEncoder::hash(const uint32_t p) const {
+	const uint32_t v =
+		  (window[(p + 0) & window_mask] << 16)
+		| (window[(p + 1) & window_mask] <<  8)
+		| (window[(p + 2) & window_mask] <<  0);
+	return (v * 2654435761U) >> (32 - hash_bits);
+}
+
+size_t DeflateEncoder::match_length(const uint32_t candidate, const size_t available) const {
+	size_t n = 0;
+	while( (n < available) && (window[(candidate + n) & window_mask] == window[(position + n) & window_mask]) ) {
+		n++;
+	}
+	return n;
+}
+
+void DeflateEncoder::write_symbol(const uint32_t symbol) {
+	/* Fixed literal/length Huffman codes, RFC 1951 3.2.6 */
+	if( symbol < 144 ) {
+		write_code(0x030 + symbol, 8);
+	} else if( symbol < 256 ) {
+		write_code(0x190 + symbol - 144, 9);
+	} else if( symbol < 280 ) {
+		write_code(0x000 + symbol - 256, 7);
+	} else {
+		write_code(0x0c0 + symbol - 280, 8);
+	}
+}
+
+void DeflateEncoder::write_match(const size_t length, const size_t distance) {
+	const auto length_code = find_code(length_codes, length);
+	write_symbol(257 + length_code);
+	write_bits(length - length_codes[length_code].base, length_codes[length_code].extra_bits);
+
+	const auto distance_code = find_code(distance_codes, distance);
+	write_code(distance_code, 5);
+	write_bits(distance - distance_codes[distance_code].base, distance_codes[distance_code].extra_bits);
+}
+
+void DeflateEncoder::write_code(const uint32_t code, const size_t length) {
+	/* Huffman codes are packed starting with the most significant bit. */
+	uint32_t reversed = 0;
+	for(size_t i=0; i<length; i++) {
+		reversed = (reversed << 1) | ((code >> i) & 1);
+	}
+	write_bits(reversed, length);
+}
+
+void DeflateEncoder::write_bits(const uint32_t bits, const size_t length) {
+	bit_buffer |= bits << bit_count;
+	bit_count += length;
+	while( bit_count >= 8 ) {
+		write_byte(bit_buffer & 0xff);
+		bit_buffer >>= 8;
+		bit_count -= 8;
+	}
+}
+
+void DeflateEncoder::write_byte(const uint8_t byte) {
+	output[output_count++] = byte;
+	if( output_count == output.size() ) {
+		flush_output();
+	}
+}
+
+void DeflateEncoder::align_to_byte() {
+	if( bit_count > 0 ) {
+		write_bits(0, 8 - bit_count);
+	}
+}
+
+void DeflateEncoder::flush_output() {
+	if( output_count > 0 ) {
+		output_handler(output.data(), output_count);
+		output_count = 0;
+	}
+}
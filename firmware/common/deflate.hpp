@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DEFLATE_H__
+#define __DEFLATE_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <functional>
+
+#include "crc.hpp"
+
+/* Streaming zlib (RFC 1950) encoder producing a single fixed-Huffman
+ * DEFLATE (RFC 1951) block. LZ77 matching uses a single-entry hash table
+ * plus the previous match distance, over a small window. RAM use is fixed
+ * (about 3.5KB), and compressed output is handed to output_handler in
+ * pieces of at most output_buffer_size bytes.
+ *
+ * Matches never extend across the end of the data passed to feed(), so
+ * feed whole records (e.g. a filtered PNG scanline) at a time.
+ */
+class DeflateEncoder {
+public:
+	using OutputHandler = std::function<void(const void* const data, const size_t length)>;
+
+	static constexpr size_t window_size = 2048;
+	static constexpr size_t max_distance = window_size / 2;
+	static constexpr size_t output_buffer_size = 512;
+
+	explicit DeflateEncoder(OutputHandler output_handler);
+
+	void feed(const void* const data, const size_t length);
+
+	/* Terminate the block, append the Adler-32 and flush all output. */
+	void finish();
+
+private:
+	static constexpr size_t window_mask = window_size - 1;
+	static constexpr size_t min_match = 3;
+	static constexpr size_t max_match = 258;
+	static constexpr size_t hash_bits = 9;
+
+	OutputHandler output_handler;
+	Adler32 adler_32 { };
+
+	std::array<uint8_t, window_size> window { };
+	std::array<uint16_t, 1 << hash_bits> head { };
+	uint32_t position { 0 };
+	uint32_t last_distance { 0 };
+
+	std::array<uint8_t, output_buffer_size> output { };
+	size_t output_count { 0 };
+	uint32_t bit_buffer { 0 };
+	size_t bit_count { 0 };
+
+	void compress(const uint8_t* const data, const size_t length);
+
+	uint32_t hash(const uint32_t p) const;
+	size_t match_length(const uint32_t candidate, const size_t available) const;
+
+	void write_symbol(const uint32_t symbol);
+	void write_match(const size_t length, const size_t distance);
+	void write_code(const uint32_t code, const size_t length);
+	void write_bits(const uint32_t bits, const size_t length);
+	void write_byte(const uint8_t byte);
+	void align_to_byte();
+	void flush_output();
+};
+
+#endif/*__DEFLATE_H__*/
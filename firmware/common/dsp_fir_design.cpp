@@ -0,0 +1,345 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_fir_design.hpp"
+
+#include "sine_table.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <array>
+
+namespace {
+
+/* Linear phase lowpass with equiripple weighted error, by the Remez
+ * exchange (Parks-McClellan). The amplitude response is a cosine
+ * polynomial of `terms` coefficients; even tap counts carry an extra
+ * cos(pi f) factor, which is divided out of the desired response and
+ * multiplied into the weight. The frequency grid is never stored: grid
+ * points are computed from their index and the extremum search keeps
+ * only three error values at a time.
+ */
+class EquirippleLowpass {
+public:
+	EquirippleLowpass(
+		const size_t count,
+		const float pass_normalized,
+		const float stop_normalized
+	) : count { std::min(count, fir_design_taps_max) },
+		terms { (this->count + 1) / 2 },
+		even { (this->count & 1) == 0 }
+	{
+		/* Even tap counts have a zero at Nyquist, so the stop band ends one
+		 * grid step short of it.
+		 */
+		const float grid_step = 0.5f / (grid_density * terms);
+		const float pass = std::max(pass_normalized, 0.0f);
+		const float stop_end = even ? (0.5f - grid_step) : 0.5f;
+		const float stop = std::min(std::max(stop_normalized, pass + grid_step), stop_end - grid_step);
+
+		pass_points = std::max<size_t>(2, std::ceil(pass / grid_step) + 1);
+		pass_step = pass / (pass_points - 1);
+		stop_points = std::max<size_t>(2, std::ceil((stop_end - stop) / grid_step) + 1);
+		stop_start = stop;
+		stop_step = (stop_end - stop) / (stop_points - 1);
+
+		design();
+		impulse_response();
+	}
+
+	float operator()(const size_t n) const {
+		return (n < count) ? h[n] : 0.0f;
+	}
+
+private:
+	static constexpr size_t grid_density = 8;
+	static constexpr size_t iterations_max = 40;
+	static constexpr float stop_weight = 150.0f;
+	static constexpr size_t extremals_max = fir_design_taps_max / 2 + 1;
+
+	const size_t count;
+	const size_t terms;
+	const bool even;
+
+	size_t pass_points { 0 };
+	float pass_step { 0.0f };
+	size_t stop_points { 0 };
+	float stop_start { 0.0f };
+	float stop_step { 0.0f };
+
+	std::array<size_t, extremals_max> extremal { };
+	std::array<float, extremals_max> x { };
+	std::array<float, extremals_max> ad { };
+	std::array<float, extremals_max> y { };
+	std::array<float, fir_design_taps_max> h { };
+
+	size_t grid_size() const {
+		return pass_points + stop_points;
+	}
+
+	float grid_frequency(const size_t i) const {
+		return (i < pass_points) ? (i * pass_step) : (stop_start + (i - pass_points) * stop_step);
+	}
+
+	float cos_factor(const float f) const {
+		return even ? std::cos(pi * f) : 1.0f;
+	}
+
+	float desired(const size_t i) const {
+		return (i < pass_points) ? (1.0f / cos_factor(grid_frequency(i))) : 0.0f;
+	}
+
+	float weight(const size_t i) const {
+		const float q = cos_factor(grid_frequency(i));
+		return (i < pass_points) ? q : (stop_weight * q);
+	}
+
+	/* Cosine polynomial through the extremal points, in barycentric form.
+	 * Takes xc = cos(2 pi f).
+	 */
+	float polynomial(const float xc) const {
+		float numer = 0.0f;
+		float denom = 0.0f;
+		for(size_t k=0; k<=terms; k++) {
+			const float d = xc - x[k];
+			if( std::abs(d) < 1e-7f ) {
+				return y[k];
+			}
+			const float c = ad[k] / d;
+			numer += c * y[k];
+			denom += c;
+		}
+		return numer / denom;
+	}
+
+	float error(const size_t i) const {
+		// One cosine per grid point: cos(2 pi f) = 2 cos(pi f)^2 - 1.
+		const float c = std::cos(pi * grid_frequency(i));
+		const float q = even ? c : 1.0f;
+		const float xc = 2.0f * c * c - 1.0f;
+		if( i < pass_points ) {
+			return 1.0f - q * polynomial(xc);
+		} else {
+			return stop_weight * q * -polynomial(xc);
+		}
+	}
+
+	void interpolate() {
+		for(size_t k=0; k<=terms; k++) {
+			x[k] = std::cos(2.0f * pi * grid_frequency(extremal[k]));
+		}
+
+		/* Barycentric weights. Taking the factors in interleaved order
+		 * keeps the running product away from float overflow/underflow.
+		 */
+		const size_t stride = (terms - 1) / 15 + 1;
+		for(size_t k=0; k<=terms; k++) {
+			float denom = 1.0f;
+			for(size_t j=0; j<stride; j++) {
+				for(size_t l=j; l<=terms; l+=stride) {
+					if( l != k ) {
+						denom *= 2.0f * (x[k] - x[l]);
+					}
+				}
+			}
+			if( std::abs(denom) < 1e-5f ) {
+				denom = 1e-5f;
+			}
+			ad[k] = 1.0f / denom;
+		}
+
+		float numer = 0.0f;
+		float denom = 0.0f;
+		float sign = 1.0f;
+		for(size_t k=0; k<=terms; k++) {
+			numer += ad[k] * desired(extremal[k]);
+			denom += sign * ad[k] / weight(extremal[k]);
+			sign = -sign;
+		}
+		const float delta = numer / denom;
+
+		sign = 1.0f;
+		for(size_t k=0; k<=terms; k++) {
+			y[k] = desired(extremal[k]) - sign * delta / weight(extremal[k]);
+			sign = -sign;
+		}
+	}
+
+	/* Moves the extremal set to the local extrema of the error, keeping
+	 * alternation. Returns true once the extrema have (nearly) equal size.
+	 */
+	bool exchange() {
+		constexpr size_t found_max = extremals_max * 2;
+		std::array<size_t, found_max> found;
+		std::array<float, found_max> found_error;
+		size_t found_count = 0;
+
+		const size_t last = grid_size() - 1;
+		float e_prev = 0.0f;
+		float e = error(0);
+		for(size_t i=0; i<=last; i++) {
+			const float e_next = (i < last) ? error(i + 1) : 0.0f;
+			const bool maximum = (e > 0.0f) && ((i == 0) || (e >= e_prev)) && ((i == last) || (e > e_next));
+			const bool minimum = (e < 0.0f) && ((i == 0) || (e <= e_prev)) && ((i == last) || (e < e_next));
+			if( (maximum || minimum) && (found_count < found_max) ) {
+				found[found_count] = i;
+				found_error[found_count] = e;
+				found_count++;
+			}
+			e_prev = e;
+			e = e_next;
+		}
+
+		if( found_count < (terms + 1) ) {
+			return true;
+		}
+
+		// Drop extra extrema: the smallest of a same-sign run, else an end.
+		while( found_count > (terms + 1) ) {
+			size_t smallest = 0;
+			bool alternates = true;
+			for(size_t j=1; j<found_count; j++) {
+				if( std::abs(found_error[j]) < std::abs(found_error[smallest]) ) {
+					smallest = j;
+				}
+				if( (found_error[j] > 0.0f) == (found_error[j - 1] > 0.0f) ) {
+					alternates = false;
+					break;
+				}
+			}
+			if( alternates ) {
+				smallest = (std::abs(found_error[found_count - 1]) < std::abs(found_error[0])) ? (found_count - 1) : 0;
+			}
+			for(size_t j=smallest; j<(found_count - 1); j++) {
+				found[j] = found[j + 1];
+				found_error[j] = found_error[j + 1];
+			}
+			found_count--;
+		}
+
+		float error_min = std::abs(found_error[0]);
+		float error_max = error_min;
+		for(size_t k=0; k<=terms; k++) {
+			extremal[k] = found[k];
+			error_min = std::min(error_min, std::abs(found_error[k]));
+			error_max = std::max(error_max, std::abs(found_error[k]));
+		}
+		return (error_max - error_min) <= (error_max * 1e-3f);
+	}
+
+	void design() {
+		const size_t last = grid_size() - 1;
+		for(size_t k=0; k<=terms; k++) {
+			extremal[k] = k * last / terms;
+		}
+
+		for(size_t iteration=0; iteration<iterations_max; iteration++) {
+			interpolate();
+			if( exchange() ) {
+				break;
+			}
+		}
+		interpolate();
+	}
+
+	// Taps from the amplitude response sampled at count points (frequency sampling).
+	void impulse_response() {
+		std::array<float, fir_design_taps_max / 2 + 1> a;
+		const size_t samples = even ? (count / 2) : terms;
+		for(size_t k=0; k<samples; k++) {
+			const float f = static_cast<float>(k) / count;
+			a[k] = cos_factor(f) * polynomial(std::cos(2.0f * pi * f));
+		}
+
+		const float half_length = (count - 1) * 0.5f;
+		for(size_t n=0; n<count; n++) {
+			const float w = 2.0f * pi * (n - half_length) / count;
+			float v = a[0];
+			for(size_t k=1; k<samples; k++) {
+				v += 2.0f * a[k] * std::cos(w * k);
+			}
+			h[n] = v / count;
+		}
+	}
+};
+
+float taps_scale(
+	const EquirippleLowpass& h,
+	const size_t count,
+	const float gain
+) {
+	float sum = 0.0f;
+	float peak = 0.0f;
+	for(size_t n=0; n<count; n++) {
+		const auto v = h(n);
+		sum += v;
+		peak = std::max(peak, std::abs(v));
+	}
+
+	float scale = gain * 32768.0f / sum;
+	if( (peak * scale) > 32767.0f ) {
+		scale = 32767.0f / peak;
+	}
+	return scale;
+}
+
+int16_t round_tap(const float v) {
+	return (v >= 0.0f) ? static_cast<int16_t>(v + 0.5f) : static_cast<int16_t>(v - 0.5f);
+}
+
+} /* namespace */
+
+void fir_design_lowpass(
+	int16_t* const taps,
+	const size_t count,
+	const float pass_normalized,
+	const float stop_normalized,
+	const float gain
+) {
+	const EquirippleLowpass h { count, pass_normalized, stop_normalized };
+	const auto scale = taps_scale(h, count, gain);
+
+	for(size_t n=0; n<count; n++) {
+		taps[n] = round_tap(h(n) * scale);
+	}
+}
+
+void fir_design_bandpass(
+	complex16_t* const taps,
+	const size_t count,
+	const float center_normalized,
+	const float pass_normalized,
+	const float stop_normalized,
+	const float gain
+) {
+	const EquirippleLowpass h { count, pass_normalized, stop_normalized };
+	const auto scale = taps_scale(h, count, gain);
+
+	const float half_length = (count - 1) * 0.5f;
+	for(size_t n=0; n<count; n++) {
+		const float v = h(n) * scale;
+		const float w = 2.0f * pi * center_normalized * (n - half_length);
+		taps[n] = {
+			round_tap(v * sin_f32(w + pi * 0.5f)),
+			round_tap(v * sin_f32(w))
+		};
+	}
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2017 Jared Boone, ShareBrained Technology, Inc.
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_FIR_DESIGN_H__
+#define __DSP_FIR_DESIGN_H__
+
+#include <cstdint>
+#include <cstddef>
+
+#include "complex.hpp"
+#include "dsp_fir_taps.hpp"
+
+/* Equiripple (Parks-McClellan) filter design, for computing taps at run
+ * time instead of carrying a table per channel bandwidth.
+ *
+ * Frequencies are normalized to the sampling rate. Stop band error is
+ * weighted 150x pass band error, trading pass band ripple for stop band
+ * attenuation. Taps are scaled for the requested gain (1.0 == 32768),
+ * reduced if the largest tap would not fit in an int16_t.
+ */
+
+constexpr size_t fir_design_taps_max = 64;
+
+void fir_design_lowpass(
+	int16_t* const taps,
+	const size_t count,
+	const float pass_normalized,
+	const float stop_normalized,
+	const float gain
+);
+
+/* Lowpass prototype of half-width pass/stop, shifted to center. */
+void fir_design_bandpass(
+	complex16_t* const taps,
+	const size_t count,
+	const float center_normalized,
+	const float pass_normalized,
+	const float stop_normalized,
+	const float gain
+);
+
+template<size_t N>
+fir_taps_real<N> fir_design_lowpass(
+	const float sampling_rate,
+	const float pass_frequency,
+	const float stop_frequency,
+	const float gain
+) {
+	static_assert(N <= fir_design_taps_max, "Too many taps for fir_design_lowpass");
+	fir_taps_real<N> result {
+		.pass_frequency_normalized = pass_frequency / sampling_rate,
+		.stop_frequency_normalized = stop_frequency / sampling_rate,
+		.taps = { },
+	};
+	fir_design_lowpass(
+		result.taps.data(), result.taps.size(),
+		result.pass_frequency_normalized, result.stop_frequency_normalized,
+		gain
+	);
+	return result;
+}
+
+/* Pass/stop frequencies are offsets from center. The normalized pass/stop
+ * frequencies of the result span from 0 Hz to the far edge of the channel,
+ * like the channel spectrum display expects.
+ */
+template<size_t N>
+fir_taps_complex<N> fir_design_bandpass(
+	const float sampling_rate,
+	const float center_frequency,
+	const float pass_frequency,
+	const float stop_frequency,
+	const float gain
+) {
+	static_assert(N <= fir_design_taps_max, "Too many taps for fir_design_bandpass");
+	const float center_abs = (center_frequency < 0) ? -center_frequency : center_frequency;
+	fir_taps_complex<N> result {
+		.pass_frequency_normalized = (center_abs + pass_frequency) / sampling_rate,
+		.stop_frequency_normalized = (center_abs + stop_frequency) / sampling_rate,
+		.taps = { },
+	};
+	fir_design_bandpass(
+		result.taps.data(), result.taps.size(),
+		center_frequency / sampling_rate,
+		pass_frequency / sampling_rate, stop_frequency / sampling_rate,
+		gain
+	);
+	return result;
+}
+
+#endif/*__DSP_FIR_DESIGN_H__*/
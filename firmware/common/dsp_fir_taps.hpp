@@ -41,43 +41,6 @@ struct fir_taps_complex {
 	std::array<complex16_t, N> taps;
 };
 
-// NBFM 16K0F3E emission type /////////////////////////////////////////////
-
-// IFIR image-reject filter: fs=3072000, pass=8000, stop=344000, decim=8, fout=384000
-constexpr fir_taps_real<24> taps_16k0_decim_0 {
-	.pass_frequency_normalized =   8000.0f / 3072000.0f,
-	.stop_frequency_normalized = 344000.0f / 3072000.0f,
-	.taps = { {
-		     1,     67,    165,    340,    599,    944,   1361,   1820,
-		  2278,   2684,   2988,   3152,   3152,   2988,   2684,   2278,
-		  1820,   1361,    944,    599,    340,    165,     67,      1,
-	} },
-};
-
-// IFIR prototype filter: fs=384000, pass=8000, stop=40000, decim=8, fout=48000
-constexpr fir_taps_real<32> taps_16k0_decim_1 {
-	.pass_frequency_normalized =  8000.0f / 384000.0f,
-	.stop_frequency_normalized = 40000.0f / 384000.0f,
-	.taps = { {
-		   -26,   -125,   -180,   -275,   -342,   -359,   -286,    -90,
-		   250,    733,   1337,   2011,   2688,   3289,   3740,   3982,
-		  3982,   3740,   3289,   2688,   2011,   1337,    733,    250,
-		   -90,   -286,   -359,   -342,   -275,   -180,   -125,    -26,
-	} },
-};
-
-// Channel filter: fs=48000, pass=8000, stop=12400, decim=1, fout=48000
-constexpr fir_taps_real<32> taps_16k0_channel {
-	.pass_frequency_normalized =  8000.0f / 48000.0f,
-	.stop_frequency_normalized = 12400.0f / 48000.0f,
-	.taps = { {
-		   -73,   -285,   -376,     -8,    609,    538,   -584,  -1387,
-		  -148,   2173,   1959,  -2146,  -5267,   -297,  12915,  24737,
-		 24737,  12915,   -297,  -5267,  -2146,   1959,   2173,   -148,
-		 -1387,   -584,    538,    609,     -8,   -376,   -285,    -73,
-	} },
-};
-
 // NBFM 11K0F3E emission type /////////////////////////////////////////////
 
 // IFIR image-reject filter: fs=3072000, pass=5500, stop=341500, decim=8, fout=384000
@@ -115,159 +78,6 @@ constexpr fir_taps_real<32> taps_11k0_channel {
 	} },
 };
 
-/// NBFM 8K50F3E emission type ////////////////////////////////////////////
-
-// IFIR image-reject filter: fs=3072000, pass=4250, stop=340250, decim=8, fout=384000
-constexpr fir_taps_real<24> taps_4k25_decim_0 {
-	.pass_frequency_normalized =   4250.0f / 3072000.0f,
-	.stop_frequency_normalized = 340250.0f / 3072000.0f,
-	.taps = { {
-		    38,    103,    222,    409,    671,   1006,   1399,   1821,
-		  2236,   2599,   2868,   3012,   3012,   2868,   2599,   2236,
-		  1821,   1399,   1006,    671,    409,    222,    103,     38,
-	} },
-};
-
-// IFIR prototype filter: fs=384000, pass=4250, stop=43750, decim=8, fout=48000
-constexpr fir_taps_real<32> taps_4k25_decim_1 {
-	.pass_frequency_normalized =  4250.0f / 384000.0f,
-	.stop_frequency_normalized = 43750.0f / 384000.0f,
-	.taps = { {
-		   -33,    -74,   -139,   -214,   -280,   -306,   -254,    -87,
-		   222,    682,   1274,   1951,   2644,   3268,   3741,   3996,
-		  3996,   3741,   3268,   2644,   1951,   1274,    682,    222,
-		   -87,   -254,   -306,   -280,   -214,   -139,    -74,    -33,
-	} },
-};
-
-// Channel filter: fs=48000, pass=4250, stop=7900, decim=1, fout=48000
-constexpr fir_taps_real<32> taps_4k25_channel {
-	.pass_frequency_normalized = 4250.0f / 48000.0f,
-	.stop_frequency_normalized = 7900.0f / 48000.0f,
-	.taps = { {
-		   -58,    -14,    153,    484,    871,   1063,    770,   -141,
-		 -1440,  -2488,  -2435,   -614,   3035,   7771,  12226,  14927,
-		 14927,  12226,   7771,   3035,   -614,  -2435,  -2488,  -1440,
-		  -141,    770,   1063,    871,    484,    153,    -14,    -58,
-	} },
-};
-
-// DSB AM 6K00A3E emission type ///////////////////////////////////////////
-
-// IFIR image-reject filter: fs=3072000, pass=3000, stop=339000, decim=8, fout=384000
-constexpr fir_taps_real<24> taps_6k0_decim_0 {
-	.pass_frequency_normalized =   3000.0f / 3072000.0f,
-	.stop_frequency_normalized = 339000.0f / 3072000.0f,
-	.taps = { {
-		    39,    104,    224,    412,    674,   1008,   1400,   1821,
-		  2234,   2594,   2863,   3006,   3006,   2863,   2594,   2234,
-		  1821,   1400,   1008,    674,    412,    224,    104,     39,
-	} },
-};
-
-// IFIR prototype filter: fs=384000, pass=3000, stop=45000, decim=8, fout=48000
-constexpr fir_taps_real<32> taps_6k0_decim_1 {
-	.pass_frequency_normalized =  3000.0f / 384000.0f,
-	.stop_frequency_normalized = 45000.0f / 384000.0f,
-	.taps = { {
-		   -26,    -63,   -123,   -195,   -263,   -295,   -253,    -99,
-		   199,    651,   1242,   1927,   2633,   3273,   3760,   4023,
-		  4023,   3760,   3273,   2633,   1927,   1242,    651,    199,
-		   -99,   -253,   -295,   -263,   -195,   -123,    -63,    -26,
-	} },
-};
-
-// IFIR prototype filter: fs=48000, pass=3000, stop=6700, decim=4, fout=12000
-constexpr fir_taps_real<32> taps_6k0_decim_2 {
-	.pass_frequency_normalized = 3000.0f / 48000.0f,
-	.stop_frequency_normalized = 6700.0f / 48000.0f,
-	.taps = { {
-		    95,    178,    247,    208,    -21,   -474,  -1080,  -1640,
-		 -1857,  -1411,    -83,   2134,   4978,   7946,  10413,  11815,
-		 11815,  10413,   7946,   4978,   2134,    -83,  -1411,  -1857,
-		 -1640,  -1080,   -474,    -21,    208,    247,    178,     95,
-	} },
-};
-
-// Channel filter: fs=12000, pass=3000, stop=3300, decim=1, fout=12000
-/* NOTE: Slightly less than 1.0 gain (normalized to 65536) due to max(taps) being
- * slightly larger than 32767 (33312).
- */
-constexpr fir_taps_complex<64> taps_6k0_dsb_channel {
-	.pass_frequency_normalized = 3000.0f / 12000.0f,
-	.stop_frequency_normalized = 3300.0f / 12000.0f,
-	.taps = { {
-		{    -69,      0 }, {   -140,      0 }, {    119,      0 }, {     89,      0 },
-		{   -132,      0 }, {   -134,      0 }, {    197,      0 }, {    167,      0 },
-		{   -273,      0 }, {   -206,      0 }, {    372,      0 }, {    247,      0 },
-		{   -497,      0 }, {   -289,      0 }, {    654,      0 }, {    331,      0 },
-		{   -854,      0 }, {   -372,      0 }, {   1112,      0 }, {    411,      0 },
-		{  -1455,      0 }, {   -446,      0 }, {   1933,      0 }, {    476,      0 },
-		{  -2654,      0 }, {   -501,      0 }, {   3902,      0 }, {    520,      0 },
-		{  -6717,      0 }, {   -531,      0 }, {  20478,      0 }, {  32767,      0 },
-		{  20478,      0 }, {   -531,      0 }, {  -6717,      0 }, {    520,      0 },
-		{   3902,      0 }, {   -501,      0 }, {  -2654,      0 }, {    476,      0 },
-		{   1933,      0 }, {   -446,      0 }, {  -1455,      0 }, {    411,      0 },
-		{   1112,      0 }, {   -372,      0 }, {   -854,      0 }, {    331,      0 },
-		{    654,      0 }, {   -289,      0 }, {   -497,      0 }, {    247,      0 },
-		{    372,      0 }, {   -206,      0 }, {   -273,      0 }, {    167,      0 },
-		{    197,      0 }, {   -134,      0 }, {   -132,      0 }, {     89,      0 },
-		{    119,      0 }, {   -140,      0 }, {    -69,      0 }, {      0,      0 },
-	} },
-};
-
-// USB AM 2K80J3E emission type ///////////////////////////////////////////
-
-// IFIR prototype filter: fs=12000, pass=3000, stop=3300, decim=1, fout=12000
-constexpr fir_taps_complex<64> taps_2k8_usb_channel {
-	.pass_frequency_normalized = 3000.0f / 12000.0f,
-	.stop_frequency_normalized = 3300.0f / 12000.0f,
-	.taps = { {
-		{   -146,      0 }, {    -41,    -45 }, {     -1,     10 }, {    -95,     69 },
-		{   -194,    -41 }, {    -91,   -158 }, {     14,    -43 }, {   -150,     67 },
-		{   -299,   -133 }, {   -100,   -307 }, {     50,    -86 }, {   -254,     54 },
-		{   -453,   -329 }, {    -62,   -587 }, {    170,   -189 }, {   -334,      0 },
-		{   -580,   -645 }, {    104,   -986 }, {    418,   -304 }, {   -412,    -88 },
-		{   -680,  -1178 }, {    527,  -1623 }, {    970,   -432 }, {   -441,   -196 },
-		{   -698,  -2149 }, {   1617,  -2800 }, {   2384,   -507 }, {   -429,   -311 },
-		{   -545,  -5181 }, {   6925,  -7691 }, {  14340,      0 }, {  10601,  11773 },
-		{  -1499,  14261 }, {  -8373,   6083 }, {  -5095,  -1083 }, {   -265,   -459 },
-		{   -753,   2318 }, {  -2954,   1315 }, {  -2064,   -919 }, {   -149,   -459 },
-		{   -531,    920 }, {  -1669,    355 }, {  -1100,   -800 }, {    -44,   -419 },
-		{   -346,    384 }, {   -992,      0 }, {   -580,   -645 }, {     35,   -332 },
-		{   -205,    149 }, {   -577,   -123 }, {   -280,   -485 }, {     80,   -247 },
-		{    -91,     40 }, {   -294,   -131 }, {   -101,   -312 }, {     82,   -142 },
-		{    -44,      9 }, {   -147,   -107 }, {    -21,   -197 }, {     79,    -88 },
-		{     10,      0 }, {    -41,    -45 }, {     15,   -145 }, {      0,      0 },
-	} },
-};
-
-// LSB AM 2K80J3E emission type ///////////////////////////////////////////
-
-// IFIR prototype filter: fs=12000, pass=3000, stop=3300, decim=1, fout=12000
-constexpr fir_taps_complex<64> taps_2k8_lsb_channel {
-	.pass_frequency_normalized = 3000.0f / 12000.0f,
-	.stop_frequency_normalized = 3300.0f / 12000.0f,
-	.taps = { {
-		{   -146,      0 }, {    -41,     45 }, {     -1,    -10 }, {    -95,    -69 },
-		{   -194,     41 }, {    -91,    158 }, {     14,     43 }, {   -150,    -67 },
-		{   -299,    133 }, {   -100,    307 }, {     50,     86 }, {   -254,    -54 },
-		{   -453,    329 }, {    -62,    587 }, {    170,    189 }, {   -334,      0 },
-		{   -580,    645 }, {    104,    986 }, {    418,    304 }, {   -412,     88 },
-		{   -680,   1178 }, {    527,   1623 }, {    970,    432 }, {   -441,    196 },
-		{   -698,   2149 }, {   1617,   2800 }, {   2384,    507 }, {   -429,    311 },
-		{   -545,   5181 }, {   6925,   7691 }, {  14340,      0 }, {  10601, -11773 },
-		{  -1499, -14261 }, {  -8373,  -6083 }, {  -5095,   1083 }, {   -265,    459 },
-		{   -753,  -2318 }, {  -2954,  -1315 }, {  -2064,    919 }, {   -149,    459 },
-		{   -531,   -920 }, {  -1669,   -355 }, {  -1100,    800 }, {    -44,    419 },
-		{   -346,   -384 }, {   -992,      0 }, {   -580,    645 }, {     35,    332 },
-		{   -205,   -149 }, {   -577,    123 }, {   -280,    485 }, {     80,    247 },
-		{    -91,    -40 }, {   -294,    131 }, {   -101,    312 }, {     82,    142 },
-		{    -44,     -9 }, {   -147,    107 }, {    -21,    197 }, {     79,     88 },
-		{     10,      0 }, {    -41,     45 }, {     15,    145 }, {      0,      0 },
-	} },
-};
-
 // WFM 200KF8E emission type //////////////////////////////////////////////
 
 // IFIR image-reject filter: fs=3072000, pass=100000, stop=484000, decim=4, fout=768000
@@ -21,8 +21,12 @@
 
 #include "dsp_iir.hpp"
 
+#include "sine_table.hpp"
+
 #include <hal.h>
 
+#include <cstdint>
+
 void IIRBiquadFilter::configure(const iir_biquad_config_t& new_config) {
 	config = new_config;
 }
@@ -55,3 +59,100 @@ void IIRBiquadFilter::execute(const buffer_f32_t& buffer_in, const buffer_f32_t&
 void IIRBiquadFilter::execute_in_place(const buffer_f32_t& buffer) {
 	execute(buffer, buffer);
 }
+
+static int32_t coefficient_to_fixed(const float value, const size_t fraction_bits, const int32_t limit) {
+	const float scaled = value * (1UL << fraction_bits);
+	const float rounded = (scaled < 0.0f) ? (scaled - 0.5f) : (scaled + 0.5f);
+	if( rounded >= limit ) {
+		return limit;
+	}
+	if( rounded <= -limit ) {
+		return -limit;
+	}
+	return static_cast<int32_t>(rounded);
+}
+
+void IIRBiquadFilterS16::configure(const iir_biquad_config_t& new_config) {
+	const int32_t b0 = coefficient_to_fixed(new_config.b[0], 14, 32767);
+	const int32_t b2_ = coefficient_to_fixed(new_config.b[2], 14, 32767);
+	// Round b1 so the quantized numerator keeps the float DC gain. Highpass
+	// sections then keep an exact zero at DC, rather than a residual that a
+	// pole pair near z=1 amplifies by orders of magnitude.
+	const float b_sum = new_config.b[0] + new_config.b[1] + new_config.b[2];
+	const int32_t b1_ideal = coefficient_to_fixed(new_config.b[1], 14, 32767);
+	const int32_t b1_dc = coefficient_to_fixed(b_sum, 14, 0x7fffffff) - b0 - b2_;
+	const int32_t b1 = ((b1_dc - b1_ideal) <= 1 && (b1_dc - b1_ideal) >= -1) ? b1_dc : b1_ideal;
+	b1_b0 = (static_cast<uint32_t>(b1) << 16) | (static_cast<uint32_t>(b0) & 0xffff);
+	b2 = b2_;
+	a1_neg = -coefficient_to_fixed(new_config.a[1], 30, 0x7fffffff);
+	a2_neg = -coefficient_to_fixed(new_config.a[2], 30, 0x7fffffff);
+}
+
+void IIRBiquadFilterS16::execute(const buffer_s16_t& buffer_in, const buffer_s16_t& buffer_out) {
+	chDbgAssert(buffer_out.count == buffer_in.count, "IIRS16Count", "");
+
+	auto x2_x1_ = x2_x1;
+	auto y1_ = y1;
+	auto y2_ = y2;
+
+	for(size_t i=0; i<buffer_out.count; i++) {
+		const int32_t x0 = buffer_in.p[i];
+		const uint32_t x1_x0 = __PKHBT(x0, x2_x1_, 16);
+		const int32_t x2 = static_cast<int32_t>(x2_x1_) >> 16;
+
+		// Q15 * Q14 -> Q29, widened so full-scale input into a gain-of-4 numerator can't wrap.
+		int64_t acc = __SMLALD(x1_x0, b1_b0, static_cast<int64_t>(x2) * b2);
+		acc <<= 31;
+		// Q30 * Q30 -> Q60
+		acc += static_cast<int64_t>(a1_neg) * y1_;
+		acc += static_cast<int64_t>(a2_neg) * y2_;
+
+		int64_t y0_wide = acc >> 30;
+		if( y0_wide > INT32_MAX ) {
+			y0_wide = INT32_MAX;
+		} else if( y0_wide < INT32_MIN ) {
+			y0_wide = INT32_MIN;
+		}
+		const int32_t y0 = static_cast<int32_t>(y0_wide);
+
+		x2_x1_ = x1_x0;
+		y2_ = y1_;
+		y1_ = y0;
+
+		buffer_out.p[i] = __SSAT(__QADD(y0, 1 << 14) >> 15, 16);
+	}
+
+	x2_x1 = x2_x1_;
+	y1 = y1_;
+	y2 = y2_;
+}
+
+void IIRBiquadFilterS16::execute_in_place(const buffer_s16_t& buffer) {
+	execute(buffer, buffer);
+}
+
+iir_biquad_config_t iir_biquad_lowpass(const float cutoff, const float sampling_rate, const float q) {
+	// http://www.musicdsp.org/files/Audio-EQ-Cookbook.txt
+	const float w0 = 2.0f * pi * cutoff / sampling_rate;
+	const float cos_w0 = sin_f32(w0 + pi * 0.5f);
+	const float alpha = sin_f32(w0) / (2.0f * q);
+	const float a0 = 1.0f + alpha;
+	const float b0 = (1.0f - cos_w0) * 0.5f / a0;
+	return {
+		{ { b0, 2.0f * b0, b0 } },
+		{ { 1.0f, -2.0f * cos_w0 / a0, (1.0f - alpha) / a0 } },
+	};
+}
+
+iir_biquad_config_t iir_biquad_highpass(const float cutoff, const float sampling_rate, const float q) {
+	// http://www.musicdsp.org/files/Audio-EQ-Cookbook.txt
+	const float w0 = 2.0f * pi * cutoff / sampling_rate;
+	const float cos_w0 = sin_f32(w0 + pi * 0.5f);
+	const float alpha = sin_f32(w0) / (2.0f * q);
+	const float a0 = 1.0f + alpha;
+	const float b0 = (1.0f + cos_w0) * 0.5f / a0;
+	return {
+		{ { b0, -2.0f * b0, b0 } },
+		{ { 1.0f, -2.0f * cos_w0 / a0, (1.0f - alpha) / a0 } },
+	};
+}
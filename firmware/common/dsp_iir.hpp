@@ -23,6 +23,9 @@
 #define __DSP_IIR_H__
 
 #include <array>
+#include <cstddef>
+
+#include "ch.h"
 
 #include "dsp_types.hpp"
 
@@ -41,6 +44,14 @@ constexpr iir_biquad_config_t iir_config_no_pass {
 	{ { 0.0f, 0.0f, 0.0f } },
 };
 
+/* Low-pass section designed at run time, a0 normalized to 1.0. A fourth-order
+ * Butterworth is two sections with q = 0.5412 and 1.3066.
+ */
+iir_biquad_config_t iir_biquad_lowpass(const float cutoff, const float sampling_rate, const float q);
+
+/* High-pass counterpart of iir_biquad_lowpass(). */
+iir_biquad_config_t iir_biquad_highpass(const float cutoff, const float sampling_rate, const float q);
+
 class IIRBiquadFilter {
 public:
 	// http://www.musicdsp.org/files/Audio-EQ-Cookbook.txt
@@ -67,4 +78,116 @@ private:
 	std::array<float, 3> y { { 0.0f, 0.0f, 0.0f } };
 };
 
+/* Cascade of N second-order sections in transposed Direct Form II. Each input
+ * sample runs through every section before the next sample is read, so the
+ * block is walked once and the section states stay in registers (N is a
+ * compile-time constant, the section loop unrolls).
+ */
+template<size_t N>
+class IIRBiquadCascade {
+public:
+	using config_t = std::array<iir_biquad_config_t, N>;
+
+	constexpr IIRBiquadCascade(
+	) : sections { }
+	{
+	}
+
+	void configure(const config_t& new_config) {
+		for(size_t n=0; n<N; n++) {
+			configure(n, new_config[n]);
+		}
+	}
+
+	// Assume all coefficients are normalized so that a0=1.0
+	void configure(const size_t index, const iir_biquad_config_t& new_config) {
+		sections[index] = {
+			new_config.b[0], new_config.b[1], new_config.b[2],
+			new_config.a[1], new_config.a[2],
+		};
+	}
+
+	void reset() {
+		state = { };
+	}
+
+	void execute(const buffer_f32_t& buffer_in, const buffer_f32_t& buffer_out) {
+		chDbgAssert(buffer_out.count == buffer_in.count, "IIRCascadeCount", "");
+
+		const auto sections_ = sections;
+		auto state_ = state;
+
+		for(size_t i=0; i<buffer_out.count; i++) {
+			float v = buffer_in.p[i];
+			for(size_t n=0; n<N; n++) {
+				const auto& c = sections_[n];
+				auto& s = state_[n];
+				const float y = c.b0 * v + s.s1;
+				s.s1 = c.b1 * v - c.a1 * y + s.s2;
+				s.s2 = c.b2 * v - c.a2 * y;
+				v = y;
+			}
+			buffer_out.p[i] = v;
+		}
+
+		state = state_;
+	}
+
+	void execute_in_place(const buffer_f32_t& buffer) {
+		execute(buffer, buffer);
+	}
+
+private:
+	struct section_t {
+		float b0;
+		float b1;
+		float b2;
+		float a1;
+		float a2;
+	};
+
+	struct state_t {
+		float s1;
+		float s2;
+	};
+
+	std::array<section_t, N> sections;
+	std::array<state_t, N> state { };
+};
+
+/* Fixed-point counterpart of IIRBiquadFilter for int16_t audio, Direct Form I.
+ * Feed-forward coefficients are Q14, applied with dual 16-bit MACs against
+ * packed input history. Feedback coefficients are Q30 and the output history
+ * is kept as Q30 in 32 bits, so high-Q, low-corner sections (30Hz HPF at
+ * 48kHz) keep their pole positions and don't limit-cycle.
+ */
+class IIRBiquadFilterS16 {
+public:
+	IIRBiquadFilterS16(
+	) : IIRBiquadFilterS16(iir_config_no_pass)
+	{
+	}
+
+	// Assume all coefficients are normalized so that a0=1.0
+	IIRBiquadFilterS16(
+		const iir_biquad_config_t& config
+	) {
+		configure(config);
+	}
+
+	void configure(const iir_biquad_config_t& new_config);
+
+	void execute(const buffer_s16_t& buffer_in, const buffer_s16_t& buffer_out);
+	void execute_in_place(const buffer_s16_t& buffer);
+
+private:
+	uint32_t b1_b0 { 0 };
+	int32_t b2 { 0 };
+	int32_t a1_neg { 0 };
+	int32_t a2_neg { 0 };
+	uint32_t x2_x1 { 0 };
+	int32_t y1 { 0 };
+	int32_t y2 { 0 };
+};
+
 #endif/*__DSP_IIR_H__*/
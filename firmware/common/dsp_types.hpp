@@ -30,6 +30,8 @@
 using buffer_c8_t = buffer_t<complex8_t>;
 using buffer_c16_t = buffer_t<complex16_t>;
 using buffer_s16_t = buffer_t<int16_t>;
+using buffer_u16_t = buffer_t<uint16_t>;
+using buffer_u32_t = buffer_t<uint32_t>;
 using buffer_c32_t = buffer_t<complex32_t>;
 using buffer_f32_t = buffer_t<float>;
 
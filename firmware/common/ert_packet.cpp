@@ -86,7 +86,7 @@ bool Packet::crc_ok() const {
 }
 
 bool Packet::crc_ok_scm() const {
-	CRC<16> ert_bch { 0x6f63 };
+	CRCTable<16, 0x6f63> ert_bch { };
 	size_t start_bit = 5;
 	ert_bch.process_byte(reader_.read(0, start_bit));
 	for(size_t i=start_bit; i<length(); i+=8) {
@@ -96,7 +96,7 @@ bool Packet::crc_ok_scm() const {
 }
 
 bool Packet::crc_ok_idm() const {
-	CRC<16> ert_crc_ccitt { 0x1021, 0xffff, 0x1d0f };
+	CRCTable<16, 0x1021> ert_crc_ccitt { 0xffff, 0x1d0f };
 	for(size_t i=0; i<length(); i+=8) {
 		ert_crc_ccitt.process_byte(reader_.read(i, 8));
 	}
@@ -34,6 +34,8 @@
 #include "baseband_packet.hpp"
 #include "ert_packet.hpp"
 #include "tpms_packet.hpp"
+#include "ais_packet.hpp"
+#include "adsb_frame.hpp"
 #include "pocsag_packet.hpp"
 #include "jammer.hpp"
 #include "dsp_fir_taps.hpp"
@@ -86,11 +88,22 @@ public:
 		JammerConfigure = 41,
 		WidebandSpectrumConfig = 42,
 		FSKConfigure = 43,
+		AMCarrier = 44,
+		AudioConfig = 45,
+		AudioLatency = 46,
+		SubtoneConfig = 47,
+		Subtone = 48,
+		WFMStatus = 49,
 		
 		POCSAGPacket = 50,
+		ADSBFrame = 51,
 		
 		FIFOSignal = 52,
 		FIFOData = 53,
+
+		AudioSpectrumConfig = 54,
+		AudioSpectrumStreamingConfig = 55,
+		Squelch = 56,
 		MAX
 	};
 
@@ -218,6 +231,170 @@ public:
 	AudioStatistics statistics;
 };
 
+/* Audio latency, averaged over an AudioStatistics interval. Times are for the
+ * oldest sample of an audio block, from RF capture to the speaker.
+ */
+struct AudioLatency {
+	uint32_t processing_us;
+	uint32_t block_us;
+	uint32_t queue_us;
+	uint32_t total_max_us;
+	size_t block_samples;
+	size_t ring_depth;
+
+	constexpr AudioLatency(
+	) : processing_us { 0 },
+		block_us { 0 },
+		queue_us { 0 },
+		total_max_us { 0 },
+		block_samples { 0 },
+		ring_depth { 0 }
+	{
+	}
+
+	constexpr AudioLatency(
+		uint32_t processing_us,
+		uint32_t block_us,
+		uint32_t queue_us,
+		uint32_t total_max_us,
+		size_t block_samples,
+		size_t ring_depth
+	) : processing_us { processing_us },
+		block_us { block_us },
+		queue_us { queue_us },
+		total_max_us { total_max_us },
+		block_samples { block_samples },
+		ring_depth { ring_depth }
+	{
+	}
+
+	constexpr uint32_t total_us() const {
+		return processing_us + block_us + queue_us;
+	}
+};
+
+class AudioLatencyMessage : public Message {
+public:
+	constexpr AudioLatencyMessage(
+		const AudioLatency& latency
+	) : Message { ID::AudioLatency },
+		latency { latency }
+	{
+	}
+
+	AudioLatency latency;
+};
+
+/* CTCSS tone or DCS code. CTCSS codes index ctcss_tones[], DCS codes are the
+ * nine-bit code word (octal 023 is 0x13).
+ */
+struct Subtone {
+	enum class Type : uint8_t {
+		None = 0,
+		CTCSS = 1,
+		DCS = 2,
+	};
+
+	Type type;
+	uint16_t code;
+	bool inverted;
+
+	constexpr Subtone(
+	) : type { Type::None },
+		code { 0 },
+		inverted { false }
+	{
+	}
+
+	constexpr Subtone(
+		Type type,
+		uint16_t code,
+		bool inverted = false
+	) : type { type },
+		code { code },
+		inverted { inverted }
+	{
+	}
+
+	constexpr bool operator==(const Subtone& other) const {
+		return (type == other.type) && (code == other.code) && (inverted == other.inverted);
+	}
+
+	constexpr bool operator!=(const Subtone& other) const {
+		return !(*this == other);
+	}
+};
+
+/* Squelch gate: audio only passes while the detected subtone matches. A gate
+ * of Type::None disables gating.
+ */
+class SubtoneConfigMessage : public Message {
+public:
+	constexpr SubtoneConfigMessage(
+		const Subtone gate
+	) : Message { ID::SubtoneConfig },
+		gate { gate }
+	{
+	}
+
+	const Subtone gate;
+};
+
+/* Sent once per detector block (~0.4 s). */
+class SubtoneMessage : public Message {
+public:
+	constexpr SubtoneMessage(
+		const Subtone detected
+	) : Message { ID::Subtone },
+		detected { detected }
+	{
+	}
+
+	Subtone detected;
+};
+
+/* Sent by AudioOutput when its squelch (noise squelch and tone gate) opens or
+ * closes. Open until told otherwise.
+ */
+class SquelchMessage : public Message {
+public:
+	constexpr SquelchMessage(
+		const bool open
+	) : Message { ID::Squelch },
+		open { open }
+	{
+	}
+
+	bool open;
+};
+
+/* RDS program data received so far. Text is space padded, not terminated. */
+struct RDSProgram {
+	bool synced { false };
+	uint16_t pi { 0 };
+	uint8_t program_type { 0 };
+	std::array<char, 8> ps { };
+	std::array<char, 64> radiotext { };
+	size_t radiotext_length { 0 };
+	uint32_t groups { 0 };
+	uint32_t block_errors { 0 };
+};
+
+class WFMStatusMessage : public Message {
+public:
+	constexpr WFMStatusMessage(
+		const bool stereo,
+		const RDSProgram& rds
+	) : Message { ID::WFMStatus },
+		stereo { stereo },
+		rds(rds)
+	{
+	}
+
+	bool stereo;
+	RDSProgram rds;
+};
+
 class SpectrumStreamingConfigMessage : public Message {
 public:
 	enum class Mode : uint32_t {
@@ -273,15 +450,52 @@ public:
 	ChannelSpectrumFIFO* fifo { nullptr };
 };
 
+/* Audio spectra reuse ChannelSpectrum, one-sided: db[i] is i * sampling_rate / 512,
+ * no channel filter.
+ */
+class AudioSpectrumConfigMessage : public Message {
+public:
+	static constexpr size_t fifo_k = 2;
+
+	constexpr AudioSpectrumConfigMessage(
+		ChannelSpectrumFIFO* fifo
+	) : Message { ID::AudioSpectrumConfig },
+		fifo { fifo }
+	{
+	}
+
+	ChannelSpectrumFIFO* fifo { nullptr };
+};
+
+class AudioSpectrumStreamingConfigMessage : public Message {
+public:
+	using Mode = SpectrumStreamingConfigMessage::Mode;
+
+	constexpr AudioSpectrumStreamingConfigMessage(
+		Mode mode,
+		uint32_t rate_hz
+	) : Message { ID::AudioSpectrumStreamingConfig },
+		mode { mode },
+		rate_hz { rate_hz }
+	{
+	}
+
+	Mode mode { Mode::Stopped };
+	uint32_t rate_hz { 0 };
+};
+
 class AISPacketMessage : public Message {
 public:
 	constexpr AISPacketMessage(
+		const ais::Channel channel,
 		const baseband::Packet& packet
 	) : Message { ID::AISPacket },
+		channel { channel },
 		packet { packet }
 	{
 	}
 
+	ais::Channel channel;
 	baseband::Packet packet;
 };
 
@@ -312,6 +526,18 @@ public:
 	pocsag::POCSAGPacket packet;
 };
 
+class ADSBFrameMessage : public Message {
+public:
+	constexpr ADSBFrameMessage(
+		const adsb::ADSBFrame& frame
+	) : Message { ID::ADSBFrame },
+		frame { frame }
+	{
+	}
+	
+	adsb::ADSBFrame frame;
+};
+
 class ShutdownMessage : public Message {
 public:
 	constexpr ShutdownMessage(
@@ -353,7 +579,8 @@ public:
 		const size_t channel_decimation,
 		const size_t deviation,
 		const iir_biquad_config_t audio_hpf_config,
-		const iir_biquad_config_t audio_deemph_config
+		const iir_biquad_config_t audio_deemph_config,
+		const size_t squelch_level
 	) : Message { ID::NBFMConfigure },
 		decim_0_filter(decim_0_filter),
 		decim_1_filter(decim_1_filter),
@@ -361,7 +588,8 @@ public:
 		channel_decimation { channel_decimation },
 		deviation { deviation },
 		audio_hpf_config(audio_hpf_config),
-		audio_deemph_config(audio_deemph_config)
+		audio_deemph_config(audio_deemph_config),
+		squelch_level { squelch_level }
 	{
 	}
 
@@ -372,6 +600,7 @@ public:
 	const size_t deviation;
 	const iir_biquad_config_t audio_hpf_config;
 	const iir_biquad_config_t audio_deemph_config;
+	const size_t squelch_level;
 };
 
 class WFMConfigureMessage : public Message {
@@ -382,14 +611,16 @@ public:
 		const fir_taps_real<64> audio_filter,
 		const size_t deviation,
 		const iir_biquad_config_t audio_hpf_config,
-		const iir_biquad_config_t audio_deemph_config
+		const iir_biquad_config_t audio_deemph_config,
+		const size_t squelch_level
 	) : Message { ID::WFMConfigure },
 		decim_0_filter(decim_0_filter),
 		decim_1_filter(decim_1_filter),
 		audio_filter(audio_filter),
 		deviation { deviation },
 		audio_hpf_config(audio_hpf_config),
-		audio_deemph_config(audio_deemph_config)
+		audio_deemph_config(audio_deemph_config),
+		squelch_level { squelch_level }
 	{
 	}
 
@@ -399,6 +630,7 @@ public:
 	const size_t deviation;
 	const iir_biquad_config_t audio_hpf_config;
 	const iir_biquad_config_t audio_deemph_config;
+	const size_t squelch_level;
 };
 
 class AMConfigureMessage : public Message {
@@ -406,6 +638,7 @@ public:
 	enum class Modulation : int32_t {
 		DSB = 0,
 		SSB = 1,
+		SAM = 2,
 	};
 
 	constexpr AMConfigureMessage(
@@ -414,14 +647,16 @@ public:
 		const fir_taps_real<32> decim_2_filter,
 		const fir_taps_complex<64> channel_filter,
 		const Modulation modulation,
-		const iir_biquad_config_t audio_hpf_config
+		const iir_biquad_config_t audio_hpf_config,
+		const size_t squelch_level
 	) : Message { ID::AMConfigure },
 		decim_0_filter(decim_0_filter),
 		decim_1_filter(decim_1_filter),
 		decim_2_filter(decim_2_filter),
 		channel_filter(channel_filter),
 		modulation { modulation },
-		audio_hpf_config(audio_hpf_config)
+		audio_hpf_config(audio_hpf_config),
+		squelch_level { squelch_level }
 	{
 	}
 
@@ -431,6 +666,38 @@ public:
 	const fir_taps_complex<64> channel_filter;
 	const Modulation modulation;
 	const iir_biquad_config_t audio_hpf_config;
+	const size_t squelch_level;
+};
+
+class AMCarrierMessage : public Message {
+public:
+	constexpr AMCarrierMessage(
+		const int32_t offset_hz,
+		const bool locked
+	) : Message { ID::AMCarrier },
+		offset_hz { offset_hz },
+		locked { locked }
+	{
+	}
+
+	const int32_t offset_hz;
+	const bool locked;
+};
+
+/* Audio DMA block size and ring depth. Handled by every baseband image. */
+class AudioConfigMessage : public Message {
+public:
+	constexpr AudioConfigMessage(
+		const size_t block_samples,
+		const size_t ring_depth
+	) : Message { ID::AudioConfig },
+		block_samples { block_samples },
+		ring_depth { ring_depth }
+	{
+	}
+
+	const size_t block_samples;
+	const size_t ring_depth;
 };
 
 // TODO: Put this somewhere else, or at least the implementation part.
@@ -721,13 +988,9 @@ public:
 class POCSAGConfigureMessage : public Message {
 public:
 	constexpr POCSAGConfigureMessage(
-		const pocsag::BitRate bitrate
-	) : Message { ID::POCSAGConfigure },
-		bitrate(bitrate)
+	) : Message { ID::POCSAGConfigure }
 	{
 	}
-
-	const pocsag::BitRate bitrate;
 };
 
 class ADSBConfigureMessage : public Message {
@@ -21,6 +21,9 @@
 
 #include "png_writer.hpp"
 
+#include <cstdlib>
+#include <algorithm>
+
 static constexpr std::array<uint8_t, 8> png_file_header { {
 	0x89, 0x50, 0x4e, 0x47,
 	0x0d, 0x0a, 0x1a, 0x0a,
@@ -49,6 +52,11 @@ static constexpr std::array<uint8_t, 12> png_iend { {
 	0xae, 0x42, 0x60, 0x82,		// CRC
 } };
 
+PNGWriter::PNGWriter(
+) : deflate { [this](const void* const p, const size_t count) { this->write_idat(p, count); } }
+{
+}
+
 Optional<File::Error> PNGWriter::create(
 	const std::filesystem::path& filename
 ) {
@@ -59,51 +67,78 @@ Optional<File::Error> PNGWriter::create(
 
 	file.write(png_file_header);
 	file.write(png_ihdr_screen_capture);
-	
-	write_chunk_header(
-		2 + height * (5 + 1 + width * 3) + 4,
-		png_idat_chunk_type
-	);
-
-	constexpr std::array<uint8_t, 2> zlib_header { 0x78, 0x01 };	// Zlib CM, CINFO, FLG.
-	write_chunk_content(zlib_header);
 
 	return { };
 }
 
 PNGWriter::~PNGWriter() {
-	write_chunk_content(adler_32.bytes());
-	write_chunk_crc();
+	deflate.finish();
 
 	file.write(png_iend);
 }
 
 void PNGWriter::write_scanline(const std::array<ui::ColorRGB888, 240>& scanline) {
-	constexpr uint8_t scanline_filter_type = 0;
-	constexpr uint32_t deflate_block_length = 1 + sizeof(scanline);
-
-	const std::array<uint8_t, 6> deflate_and_scanline_header {
-		static_cast<uint8_t>((scanline_count == (height - 1)) ? 0x01 : 0x00),	// DEFLATE header bits, bfinal=0, btype=00
-		static_cast<uint8_t>((deflate_block_length >> 0) & 0xff),			// Length LSB
-		static_cast<uint8_t>((deflate_block_length >> 8) & 0xff),			// Length MSB
-		static_cast<uint8_t>((deflate_block_length >> 0) & 0xff) ^ 0xff,	// ~Length LSB
-		static_cast<uint8_t>((deflate_block_length >> 8) & 0xff) ^ 0xff,	// ~Length MSB
-		scanline_filter_type,
-	};
-	write_chunk_content(deflate_and_scanline_header);
-
-	adler_32.feed(scanline_filter_type);
-	adler_32.feed(scanline);
-
-	// Small writes to avoid some sort of large-transfer plus block
-	// boundary FatFs or SDC driver bug?
-	write_chunk_content(&scanline[  0], 80 * sizeof(ui::ColorRGB888));
-	write_chunk_content(&scanline[ 80], 80 * sizeof(ui::ColorRGB888));
-	write_chunk_content(&scanline[160], 80 * sizeof(ui::ColorRGB888));
+	static_assert(sizeof(scanline) == scanline_bytes, "ColorRGB888 is not packed");
+	const auto p = reinterpret_cast<const uint8_t*>(scanline.data());
 
+	filter_scanline(p, choose_filter(p));
+	deflate.feed(filtered_scanline.data(), filtered_scanline.size());
+
+	std::copy(p, p + scanline_bytes, previous_scanline.begin());
 	scanline_count++;
 }
 
+PNGWriter::FilterType PNGWriter::choose_filter(const uint8_t* const scanline) const {
+	/* Minimum sum of absolute differences heuristic, as used by libpng. */
+	uint32_t sum_none = 0;
+	uint32_t sum_sub = 0;
+	uint32_t sum_up = 0;
+	for(size_t i=0; i<scanline_bytes; i++) {
+		const uint8_t left = (i >= bytes_per_pixel) ? scanline[i - bytes_per_pixel] : 0;
+		sum_none += std::abs(static_cast<int8_t>(scanline[i]));
+		sum_sub += std::abs(static_cast<int8_t>(scanline[i] - left));
+		sum_up += std::abs(static_cast<int8_t>(scanline[i] - previous_scanline[i]));
+	}
+
+	if( (scanline_count > 0) && (sum_up < sum_sub) && (sum_up < sum_none) ) {
+		return FilterType::Up;
+	}
+	if( sum_sub < sum_none ) {
+		return FilterType::Sub;
+	}
+	return FilterType::None;
+}
+
+void PNGWriter::filter_scanline(const uint8_t* const scanline, const FilterType filter_type) {
+	filtered_scanline[0] = static_cast<uint8_t>(filter_type);
+	auto out = &filtered_scanline[1];
+
+	switch(filter_type) {
+	case FilterType::Sub:
+		for(size_t i=0; i<scanline_bytes; i++) {
+			const uint8_t left = (i >= bytes_per_pixel) ? scanline[i - bytes_per_pixel] : 0;
+			out[i] = scanline[i] - left;
+		}
+		break;
+
+	case FilterType::Up:
+		for(size_t i=0; i<scanline_bytes; i++) {
+			out[i] = scanline[i] - previous_scanline[i];
+		}
+		break;
+
+	default:
+		std::copy(scanline, scanline + scanline_bytes, out);
+		break;
+	}
+}
+
+void PNGWriter::write_idat(const void* const p, const size_t count) {
+	write_chunk_header(count, png_idat_chunk_type);
+	write_chunk_content(p, count);
+	write_chunk_crc();
+}
+
 void PNGWriter::write_chunk_header(
 	const size_t length,
 	const std::array<uint8_t, 4>& type
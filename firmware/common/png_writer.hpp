@@ -30,9 +30,17 @@
 #include "ui.hpp"
 #include "file.hpp"
 #include "crc.hpp"
+#include "deflate.hpp"
 
+/* Image data is filtered per scanline (None, Sub or Up, whichever looks
+ * cheapest) and DEFLATE compressed. Compressed data is written as a series
+ * of IDAT chunks as the encoder output buffer fills.
+ *
+ * Too large for a thread stack, allocate on the heap.
+ */
 class PNGWriter {
 public:
+	PNGWriter();
 	~PNGWriter();
 
 	Optional<File::Error> create(const std::filesystem::path& filename);
@@ -43,11 +51,27 @@ private:
 	// TODO: These constants are baked in a few places, do not change blithely.
 	static constexpr int width { 240 };
 	static constexpr int height { 320 };
+	static constexpr size_t bytes_per_pixel { 3 };
+	static constexpr size_t scanline_bytes { width * bytes_per_pixel };
+
+	enum class FilterType : uint8_t {
+		None = 0,
+		Sub = 1,
+		Up = 2,
+	};
 
 	File file { };
 	int scanline_count { 0 };
-	CRC<32, true, true> crc { 0x04c11db7, 0xffffffff, 0xffffffff };
-	Adler32 adler_32 { };
+	CRCTable<32, 0x04c11db7, true, true, 4> crc { 0xffffffff, 0xffffffff };
+	DeflateEncoder deflate;
+
+	std::array<uint8_t, scanline_bytes> previous_scanline { };
+	std::array<uint8_t, 1 + scanline_bytes> filtered_scanline { };
+
+	FilterType choose_filter(const uint8_t* const scanline) const;
+	void filter_scanline(const uint8_t* const scanline, const FilterType filter_type);
+
+	void write_idat(const void* const p, const size_t count);
 
 	void write_chunk_header(const size_t length, const std::array<uint8_t, 4>& type);
 	void write_chunk_content(const void* const p, const size_t count);
@@ -49,32 +49,8 @@ std::string flag_str(PacketFlag packetflag) {
 	}
 }
 
-void insert_BCH(BCHCode& BCH_code, uint32_t * codeword) {
-	uint32_t parity = 0;
-	int data[21];
-	int bit;
-	int * bb;
-	size_t c;
-	
-	for (c = 0; c < 21; c++) {
-		bit = (((*codeword) << c) & 0x80000000U) ? 1 : 0;
-		if (bit) parity++;
-		data[c] = bit;
-	}
-	
-	bb = BCH_code.encode(data);
-	
-	// Make sure ECC bits are cleared
-	(*codeword) &= 0xFFFFF801;
-	
-	for (c = 0; c < 10; c++) {
-		bit = bb[c];
-		(*codeword) |= (bit << (10 - c));
-		if (bit) parity++;
-	}
-	
-	// Even parity
-	(*codeword) |= (parity & 1);
+void insert_BCH(uint32_t * codeword) {
+	(*codeword) = BCHCode::encode(*codeword);
 }
 
 uint32_t get_digit_code(char code) {
@@ -104,7 +80,7 @@ uint32_t get_digit_code(char code) {
 }
 	
 void pocsag_encode(
-	const MessageType type, BCHCode& BCH_code, const std::string message, const uint32_t address,
+	const MessageType type, const std::string message, const uint32_t address,
 	std::vector<uint32_t>& codewords) {
 	
 	size_t b, c, address_slot;
@@ -126,7 +102,7 @@ void pocsag_encode(
 	if (type == MessageType::ALPHANUMERIC)
 		codeword |= (3 << 11);
 	
-	insert_BCH(BCH_code, &codeword);
+	insert_BCH(&codeword);
 	
 	// Address batch
 	codewords.push_back(POCSAG_SYNCWORD);
@@ -174,7 +150,7 @@ void pocsag_encode(
 					
 					codeword &= 0x7FFFF800;		// Trim data
 					codeword |= 0x80000000;		// Message type
-					insert_BCH(BCH_code, &codeword);
+					insert_BCH(&codeword);
 					
 					codewords.push_back(codeword);
 					
@@ -205,7 +181,7 @@ void pocsag_encode(
 					} while (bit_idx > 11);
 					
 					codeword |= 0x80000000;		// Message type
-					insert_BCH(BCH_code, &codeword);
+					insert_BCH(&codeword);
 					
 					codewords.push_back(codeword);
 					
@@ -133,6 +133,14 @@ static inline int32_t smlad(const vec2_s16 v1, const vec2_s16 v2, const int32_t
 	return __SMLAD(v1.w, v2.w, accum);
 }
 
+static inline int32_t smlsdx(const vec2_s16 v1, const vec2_s16 v2, const int32_t accum) {
+	return __SMLSDX(v1.w, v2.w, accum);
+}
+
+static inline int32_t smladx(const vec2_s16 v1, const vec2_s16 v2, const int32_t accum) {
+	return __SMLADX(v1.w, v2.w, accum);
+}
+
 #endif /* defined(LPC43XX_M4) */
 
 #endif/*__SIMD_H__*/
@@ -146,4 +146,38 @@ inline float sin_f32(const float w) {
 	return result;
 }
 
+/* sin() of a phase accumulator, one cycle per 2^32. */
+inline float sin_f32_phase(const uint32_t phase) {
+	constexpr size_t frac_bits = 32 - sine_table_f32_period_log2;
+	constexpr float frac_scale = 1.0f / (1U << frac_bits);
+
+	const size_t n = phase >> frac_bits;
+	const float n_frac = (phase & ((1U << frac_bits) - 1)) * frac_scale;
+
+	const float p0 = sine_table_f32[n + 0];
+	const float p1 = sine_table_f32[n + 1];
+	return p0 + n_frac * (p1 - p0);
+}
+
+/* cos in low half, sin in high half, Q15, for rotating packed complex16_t
+ * samples with SMUAD/SMUSD and friends.
+ */
+struct sine_table_rotation_q15_t {
+	uint32_t w[sine_table_f32_period];
+};
+
+constexpr int32_t sine_table_to_q15(const float v) {
+	return static_cast<int32_t>(v * 32767.0f + ((v >= 0.0f) ? 0.5f : -0.5f));
+}
+
+constexpr sine_table_rotation_q15_t make_sine_table_rotation_q15() {
+	sine_table_rotation_q15_t t { };
+	for(size_t i=0; i<sine_table_f32_period; i++) {
+		const auto c = sine_table_to_q15(sine_table_f32[(i + sine_table_f32_period / 4) & sine_table_f32_index_mask]);
+		const auto s = sine_table_to_q15(sine_table_f32[i]);
+		t.w[i] = (static_cast<uint32_t>(s & 0xffff) << 16) | static_cast<uint32_t>(c & 0xffff);
+	}
+	return t;
+}
+
 #endif/*__SINE_TABLE_H__*/
@@ -63,6 +63,7 @@ private:
 	char c[4];
 };
 
+constexpr image_tag_t image_tag_adsb_rx				{ 'P', 'A', 'D', 'R' };
 constexpr image_tag_t image_tag_ais					{ 'P', 'A', 'I', 'S' };
 constexpr image_tag_t image_tag_am_audio			{ 'P', 'A', 'M', 'A' };
 constexpr image_tag_t image_tag_capture				{ 'P', 'C', 'A', 'P' };